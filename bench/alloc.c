@@ -0,0 +1,55 @@
+/* Allocation throughput. Each round builds a list of short lists, as */
+/* reading or evaluating a line does, drops it and then reclaims it   */
+/* as the prompt would between lines. A second run makes temporaries  */
+/* that die at once, as most values made while evaluating do, which   */
+/* the nursery never puts on a free list. Run it once as built and    */
+/* once with -DVHISP_MALLOC to compare with the system allocator.     */
+
+#include <stdio.h>
+
+typedef struct lval lval;
+
+lval* lval_qexpr(void);
+lval* lval_add(lval* v, lval* x);
+void lval_del(lval* v);
+void lfree_drain(void);
+void lgc_minor(void);
+long lclock_ns(void);
+
+#define ROUNDS 2000
+#define LISTS 1000
+#define ITEMS 4
+#define TEMPS 10000
+
+int main(void) {
+
+  long nodes = (long)ROUNDS * (1 + LISTS * (1 + ITEMS));
+  long start = lclock_ns();
+  for (int r = 0; r < ROUNDS; r++) {
+    lval* v = lval_qexpr();
+    for (int i = 0; i < LISTS; i++) {
+      lval* x = lval_qexpr();
+      for (int j = 0; j < ITEMS; j++) {
+        x = lval_add(x, lval_qexpr());
+      }
+      v = lval_add(v, x);
+    }
+    lval_del(v);
+    lfree_drain();
+    lgc_minor();
+  }
+  long t = lclock_ns() - start;
+  printf("lists        %.1f ns per node\n", (double)t / nodes);
+
+  start = lclock_ns();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < TEMPS; i++) {
+      lval_del(lval_qexpr());
+    }
+    lgc_minor();
+  }
+  t = lclock_ns() - start;
+  printf("temporaries  %.1f ns per node\n", (double)t / ((long)ROUNDS * TEMPS));
+
+  return 0;
+}
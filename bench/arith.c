@@ -0,0 +1,86 @@
+/* Time for each arithmetic operator to fold its arguments with its   */
+/* own kernel, and with the dispatch the kernels replaced, which      */
+/* compared the operator by name for every argument. The old dispatch */
+/* is given the numbers as plain longs and checks nothing for         */
+/* overflow, which flatters it.                                       */
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct lval lval;
+
+lval* lval_num(long x);
+long lclock_ns(void);
+extern char* larith_names[];
+extern int (*larith_kernels[])(long*, lval**, int);
+
+#define OPS 10
+#define ARGS 8
+#define CALLS 4000000
+
+long lpow_long(long x, long y) {
+  long r = 1;
+  while (y-- > 0) { r *= x; }
+  return r;
+}
+
+long strcmp_fold(char* op, long* ys, int n) {
+
+  long x = ys[0];
+  if ((strcmp(op, "-") == 0) && n == 1) { x = -x; }
+
+  for (int i = 1; i < n; i++) {
+    long y = ys[i];
+    if (strcmp(op, "+") == 0) { x += y; }
+    if (strcmp(op, "-") == 0) { x -= y; }
+    if (strcmp(op, "*") == 0) { x *= y; }
+    if (strcmp(op, "/") == 0) {
+      if (y == 0) { break; }
+      x /= y;
+    }
+    else if (strcmp(op, "%") == 0) { x %= y; }
+    else if (strcmp(op, "&") == 0) { x &= y; }
+    else if (strcmp(op, "|") == 0) { x |= y; }
+    else if (strcmp(op, "**") == 0) { x = lpow_long(x, y); }
+    else if (strcmp(op, "min") == 0) { if (y < x) { x = y; } }
+    else if (strcmp(op, "max") == 0) { if (y > x) { x = y; } }
+  }
+  return x;
+}
+
+int main(void) {
+
+  /* Ones and twos keep every operator clear of overflow */
+  long ys[ARGS];
+  lval* xs[ARGS];
+  for (int i = 0; i < ARGS; i++) {
+    ys[i] = i % 2 + 1;
+    xs[i] = lval_num(ys[i]);
+  }
+
+  volatile long sink;
+  printf("%4s %12s %12s   (%d arguments)\n", "op", "ns/kernel", "ns/strcmp", ARGS);
+
+  for (int op = 0; op < OPS; op++) {
+
+    long start = lclock_ns();
+    for (int i = 0; i < CALLS; i++) {
+      long x = ys[0];
+      larith_kernels[op](&x, xs, ARGS);
+      sink = x;
+    }
+    long t = lclock_ns() - start;
+
+    start = lclock_ns();
+    for (int i = 0; i < CALLS; i++) {
+      sink = strcmp_fold(larith_names[op], ys, ARGS);
+    }
+    long u = lclock_ns() - start;
+
+    printf("%4s %12.1f %12.1f\n", larith_names[op],
+      (double)t / CALLS, (double)u / CALLS);
+  }
+
+  (void)sink;
+  return 0;
+}
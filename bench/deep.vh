@@ -0,0 +1,10 @@
+(def {nest} (\ {n acc} {if n (nest (- n 1) (list acc)) acc}))
+(def {l} (nest 1000000 {}))
+(gc {})
+(def {peel} (\ {n l} {if n (peel (- n 1) (eval (head l))) l}))
+(peel 999999 l)
+(def {m} (list l l))
+l
+(def {l} 0)
+(def {m} 0)
+(gc {})
@@ -0,0 +1,4 @@
+(def {poly} (\ {n acc} {if n (poly (- n 1) (+ acc (mod (+ (* n n n) (* 3 n n) (* 7 n) 11) 1009))) acc}))
+(poly 300000 0)
+(def {mix} (\ {n acc} {if n (mix (- n 1) (mod (+ (* acc 31) (and n 255) (or n 3) (/ n 7)) 65521)) acc}))
+(mix 300000 1)
@@ -0,0 +1,87 @@
+/* Time to look a name up in the top-level environment by how many */
+/* names it binds, to load a symbol already given its address, as   */
+/* evaluated code does, and to unbind a name and bind it again.     */
+/* Lookups cycle through names spread evenly over the environment   */
+/* so they are not all served from one cache line.                  */
+
+#include <stdio.h>
+
+typedef struct lval lval;
+typedef struct lenv lenv;
+
+lval* lval_num(long x);
+lval* lval_sym(char* s);
+void lval_del(lval* v);
+char* lsym_intern(char* s);
+lenv* lenv_new(void);
+void lenv_del(lenv* e);
+void lenv_put(lenv* e, lval* k, lval* v);
+void lenv_remove(lenv* e, lval* k);
+lval* lenv_lookup(lenv* e, char* sym);
+lval* lenv_peek(lenv* e, char* sym);
+lval* lenv_get(lenv* e, lval* k);
+lval* lval_resolve(lenv* e, lval* v);
+long lclock_ns(void);
+
+#define PROBES 1024
+#define LOOKUPS 4000000
+#define REBINDS 1000000
+
+int main(void) {
+
+  printf("%8s %12s %12s %12s\n", "names", "ns/lookup", "ns/load", "ns/rebind");
+
+  for (int size = 16; size <= 1 << 20; size *= 16) {
+
+    lenv* e = lenv_new();
+    char name[32];
+    for (int i = 0; i < size; i++) {
+      snprintf(name, sizeof(name), "name%d", i);
+      lval* k = lval_sym(name);
+      lval* v = lval_num(i);
+      lenv_put(e, k, v);
+      lval_del(k); lval_del(v);
+    }
+
+    char* probes[PROBES];
+    lval* syms[PROBES];
+    for (int i = 0; i < PROBES; i++) {
+      snprintf(name, sizeof(name), "name%ld", (long)i * size / PROBES);
+      probes[i] = lsym_intern(name);
+      syms[i] = lval_resolve(e, lval_sym(name));
+    }
+
+    long start = lclock_ns();
+    for (int i = 0; i < LOOKUPS; i++) {
+      lval_del(lenv_lookup(e, probes[i % PROBES]));
+    }
+    long t = lclock_ns() - start;
+
+    start = lclock_ns();
+    for (int i = 0; i < LOOKUPS; i++) {
+      lval_del(lenv_get(e, syms[i % PROBES]));
+    }
+    long u = lclock_ns() - start;
+
+    /* A removed name must read as unbound until it is bound again */
+    lval* v = lval_num(0);
+    start = lclock_ns();
+    for (int i = 0; i < REBINDS; i++) {
+      lenv_remove(e, syms[i % PROBES]);
+      if (lenv_peek(e, probes[i % PROBES])) {
+        fprintf(stderr, "%s still bound after removal\n", probes[i % PROBES]);
+        return 1;
+      }
+      lenv_put(e, syms[i % PROBES], v);
+    }
+    long w = lclock_ns() - start;
+    lval_del(v);
+
+    printf("%8d %12.1f %12.1f %12.1f\n", size,
+      (double)t / LOOKUPS, (double)u / LOOKUPS, (double)w / REBINDS);
+    for (int i = 0; i < PROBES; i++) { lval_del(syms[i]); }
+    lenv_del(e);
+  }
+
+  return 0;
+}
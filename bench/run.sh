@@ -0,0 +1,68 @@
+#!/bin/sh
+# Runs the benchmarks listed at the end of this file. A C benchmark,
+# bench/NAME.c, is built along with src/ compiled with -DVHISP_NO_MAIN,
+# once for each set of extra flags it is listed with, and prints its own
+# table. A script benchmark, bench/NAME.vh, is run by vhisp built with
+# the given extra flags on each backend listed, and timed from outside.
+# CC and CFLAGS are used as by tests/run.sh. Name benchmarks to run only
+# those.
+#
+#   bench/run.sh
+#   bench/run.sh lookup
+
+cd "$(dirname "$0")" || exit 1
+
+CC=${CC:-cc}
+bin=$(mktemp)
+
+# Checks a benchmark was asked for
+wanted() {
+  [ -z "$only" ] && return 0
+  for w in $only; do [ "$w" = "$1" ] && return 0; done
+  return 1
+}
+
+# cbench NAME [FLAGS...]
+cbench() {
+  name=$1
+  shift
+  wanted "$name" || return 0
+  echo "== $name${*:+ with $*}"
+  $CC -O2 $CFLAGS "$@" -DVHISP_NO_MAIN ../src/main.c ../src/mpc.c "$name.c" \
+    -lm -o "$bin" || exit 1
+  "$bin"
+  echo
+}
+
+now_ms() {
+  echo $(($(date +%s%N) / 1000000))
+}
+
+# vbench NAME FLAGS BACKEND...
+vbench() {
+  name=$1
+  flags=$2
+  shift 2
+  wanted "$name" || return 0
+  echo "== $name${flags:+ with $flags}"
+  $CC -O2 $CFLAGS $flags ../src/main.c ../src/mpc.c -ledit -lm -o "$bin" \
+    || exit 1
+  for backend; do
+    start=$(now_ms)
+    { echo "backend {$backend}"; cat "$name.vh"; } | "$bin" > /dev/null
+    printf "%-8s %8d ms\n" "$backend" $(($(now_ms) - start))
+  done
+  echo
+}
+
+only="$*"
+
+cbench lookup
+cbench arith
+cbench alloc
+cbench alloc -DVHISP_MALLOC
+vbench kernel "" tree vm closure tiered
+vbench kernel -DVHISP_NO_JIT closure tiered
+vbench deep "" tree vm closure tiered
+
+rm -f "$bin"
@@ -1,43 +1,523 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/resource.h>
 
 #include <editline/readline.h>
 #include <editline/history.h>
 
 #include "mpc.h"
 
+/* Arithmetic closures are compiled to native code where possible */
+#if defined(__x86_64__) && !defined(VHISP_NO_JIT)
+#define VHISP_JIT
+#include <sys/mman.h>
+#endif
+
+/* Long arithmetic reductions use vector instructions where available */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(VHISP_NO_SIMD)
+#define VHISP_SIMD
+#include <immintrin.h>
+#endif
+
 struct lval;
 struct lenv;
 typedef struct lval lval;
 typedef struct lenv lenv;
 
+/* Symbol Table */
+
+/* Every distinct symbol name is stored exactly once. Symbols hold the */
+/* interned pointer, so two symbols are equal iff their pointers are.  */
+
+struct {
+  int count;
+  int cap;
+  char** names;
+} lsyms = { 0, 0, NULL };
+
+unsigned long lsym_hash(char* s) {
+  /* FNV-1a */
+  unsigned long h = 14695981039346656037UL;
+  while (*s) {
+    h ^= (unsigned char)*s++;
+    h *= 1099511628211UL;
+  }
+  return h;
+}
+
+int lsym_find(char** names, int cap, char* s) {
+  int mask = cap - 1;
+  int i = lsym_hash(s) & mask;
+  while (names[i] && strcmp(names[i], s) != 0) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+char* lsym_intern(char* s) {
+  
+  /* Grow the table to keep the load factor under 1/2 */
+  if ((lsyms.count + 1) * 2 > lsyms.cap) {
+    int cap = lsyms.cap ? lsyms.cap * 2 : 256;
+    char** names = calloc(cap, sizeof(char*));
+    for (int i = 0; i < lsyms.cap; i++) {
+      if (lsyms.names[i]) {
+        names[lsym_find(names, cap, lsyms.names[i])] = lsyms.names[i];
+      }
+    }
+    free(lsyms.names);
+    lsyms.names = names;
+    lsyms.cap = cap;
+  }
+  
+  int i = lsym_find(lsyms.names, lsyms.cap, s);
+  if (!lsyms.names[i]) {
+    lsyms.names[i] = malloc(strlen(s) + 1);
+    strcpy(lsyms.names[i], s);
+    lsyms.count++;
+  }
+  return lsyms.names[i];
+}
+
 /* Lisp Value */
 
 enum { LVAL_ERR, LVAL_NUM,   LVAL_SYM, 
-       LVAL_FUN, LVAL_SEXPR, LVAL_QEXPR };
+       LVAL_FUN, LVAL_SEXPR, LVAL_QEXPR, LVAL_BIG,
+       LVAL_LAMBDA };
 
-typedef lval*(*lbuiltin)(lenv*, lval*);
+/* Builtins borrow their arguments; see lprim below */
+typedef lval*(*lbuiltin)(lenv*, int, lval**);
+typedef lval*(*lbuiltin1)(lenv*, lval*);
+typedef lval*(*lbuiltin2)(lenv*, lval*, lval*);
+typedef struct lprim lprim;
+
+/* Values are reference counted and immutable while shared. Functions  */
+/* taking an lval* consume one reference; anything that wants to       */
+/* mutate a value must first make sure it is the only owner.           */
+
+/* Only one variant is ever live, so the payloads share a union. The  */
+/* tag and reference count that every access touches come first, and  */
+/* a node is 24 bytes on LP64 so list elements pack densely in cache.  */
 
 struct lval {
-  int type;
-  long num;
-  char* err;
-  char* sym;
-  lbuiltin fun;
-  int count;
-  lval** cell;
+  unsigned char type;
+  unsigned char flags;
+  int refs;
+  union {
+    long num;
+    char* err;
+    struct {
+      char* sym;
+      int slot;
+      int depth;
+    };
+    lprim* fun;
+    lval* fwd;
+    struct {
+      uint32_t* digits;
+      int size;
+    };
+    struct {
+      lval** cell;
+      int count;
+    };
+    struct {
+      lval* code;
+      lenv* env;
+    };
+  };
 };
 
+/* Bits of lval.flags */
+#define LGC_MARKED 1
+#define LGC_REMEMBERED 2
+#define LVAL_COMPILED 4
+
+/* Allocator */
+
+/* Nodes and cell arrays come from per-thread slabs split into size    */
+/* classes. Freed blocks go on their class free list and are reused    */
+/* before a slab is carved any further. Cell arrays are sized to the   */
+/* next power of two above their count, so growing a list by one only  */
+/* moves it when it crosses a power of two. Build with -DVHISP_MALLOC  */
+/* to use the system allocator instead, e.g. to compare the two.       */
+/*                                                                     */
+/* The runtime is single threaded. The symbol table, the collector's   */
+/* roots and environments, the code cache and the evaluator's stacks   */
+/* are process globals without locks, and a collection sweeps only the */
+/* slabs of the thread running it. The slabs, the nursery, the         */
+/* deferred free queue and the remembered set are thread local only so */
+/* that allocating never takes a lock. They do not make it safe to use */
+/* the runtime, or any value it made, from two threads at once.        */
+/*                                                                     */
+/* Both modes can enumerate every live node for the collector: freed   */
+/* blocks are tagged LHEAP_FREE inside their slab, and in malloc mode  */
+/* nodes carry a hidden link in a list of all nodes.                   */
+/*                                                                     */
+/* In slab mode new nodes are first bump allocated from a nursery.     */
+/* Nodes that die there are never put on a free list; the whole region */
+/* is reset by lgc_minor once the survivors have been promoted into    */
+/* the node slabs. When the nursery is full nodes go to the slabs.     */
+
+#define LSLAB_SIZE 65536
+#define LCELL_CLASSES 9
+
+/* Class 0 holds nodes, classes 1 to LCELL_CLASSES hold cell arrays */
+/* of 2, 4, 8 ... 512 entries and the last class counts larger ones */
+/* which always go to the system allocator.                         */
+#define LHEAP_NODE 0
+#define LHEAP_LARGE (LCELL_CLASSES + 1)
+
+#define LNURSERY_SIZE (256 * 1024)
+
+#define LHEAP_FREE 0xff
+#define LHEAP_FORWARD 0xfe
+
+/* Free blocks keep the tag byte where an lval keeps its type */
+typedef struct lblock {
+  unsigned char type;
+  struct lblock* next;
+} lblock;
+
+typedef struct {
+  lblock* free;
+  char* bump;
+  char* end;
+  char** slab;
+  long allocs;
+  long frees;
+  long live;
+  long slabs;
+} lclass;
+
+_Thread_local lclass lheap[LHEAP_LARGE + 1];
+
+typedef struct {
+  char* start;
+  char* bump;
+  char* end;
+  long live;
+  long allocs;
+  long promoted;
+  long collections;
+} lnursery_t;
+
+_Thread_local lnursery_t lnursery;
+
+#ifdef VHISP_MALLOC
+typedef struct lnode {
+  struct lnode* prev;
+  struct lnode* next;
+} lnode;
+
+_Thread_local lnode lnodes;
+#endif
+
+size_t lheap_size(int c) {
+  if (c == LHEAP_NODE) { return sizeof(lval); }
+  return sizeof(lval*) << c;
+}
+
+/* Takes a block from class c without touching the statistics */
+void* lheap_take(int c) {
+  
+#ifdef VHISP_MALLOC
+  if (c == LHEAP_NODE) {
+    /* Link the node in behind its hidden header */
+    if (!lnodes.next) { lnodes.next = lnodes.prev = &lnodes; }
+    lnode* n = malloc(sizeof(lnode) + lheap_size(c));
+    n->prev = &lnodes;
+    n->next = lnodes.next;
+    lnodes.next->prev = n;
+    lnodes.next = n;
+    return n + 1;
+  }
+  return malloc(lheap_size(c));
+#else
+  lclass* k = &lheap[c];
+  
+  /* Reuse a freed block if there is one */
+  if (k->free) {
+    lblock* b = k->free;
+    k->free = b->next;
+    return b;
+  }
+  
+  /* Otherwise carve the next block, starting a new slab if needed */
+  size_t size = lheap_size(c);
+  if (k->bump == NULL || k->bump + size > k->end) {
+    k->bump = malloc(LSLAB_SIZE);
+    k->end = k->bump + LSLAB_SIZE;
+    k->slab = realloc(k->slab, sizeof(char*) * (k->slabs + 1));
+    k->slab[k->slabs++] = k->bump;
+  }
+  void* p = k->bump;
+  k->bump += size;
+  return p;
+#endif
+}
+
+void* lheap_alloc(int c) {
+  lheap[c].allocs++;
+  lheap[c].live++;
+  return lheap_take(c);
+}
+
+void lheap_free(int c, void* p) {
+  
+  lclass* k = &lheap[c];
+  k->frees++;
+  k->live--;
+  
+#ifdef VHISP_MALLOC
+  if (c == LHEAP_NODE) {
+    lnode* n = (lnode*)p - 1;
+    n->prev->next = n->next;
+    n->next->prev = n->prev;
+    p = n;
+  }
+  free(p);
+#else
+  lblock* b = p;
+  b->type = LHEAP_FREE;
+  b->next = k->free;
+  k->free = b;
+#endif
+}
+
+/* Calls fn on every allocated node. fn may free the node it is given. */
+void lheap_walk(void (*fn)(lval*)) {
+#ifdef VHISP_MALLOC
+  if (!lnodes.next) { return; }
+  lnode* n = lnodes.next;
+  while (n != &lnodes) {
+    lnode* next = n->next;
+    fn((lval*)(n + 1));
+    n = next;
+  }
+#else
+  for (char* p = lnursery.start; p < lnursery.bump; p += sizeof(lval)) {
+    lval* v = (lval*)p;
+    if (v->type != LHEAP_FREE && v->type != LHEAP_FORWARD) { fn(v); }
+  }
+  
+  lclass* k = &lheap[LHEAP_NODE];
+  for (int i = 0; i < k->slabs; i++) {
+    /* Only the newest slab is partly carved */
+    char* p = k->slab[i];
+    char* end = (i == k->slabs - 1) ? k->bump : p + LSLAB_SIZE;
+    for (; p + sizeof(lval) <= end; p += sizeof(lval)) {
+      lval* v = (lval*)p;
+      if (v->type != LHEAP_FREE) { fn(v); }
+    }
+  }
+#endif
+}
+
+int lval_in_nursery(lval* v) {
+  return (uintptr_t)v >= (uintptr_t)lnursery.start
+      && (uintptr_t)v < (uintptr_t)lnursery.end;
+}
+
+lval* lval_alloc(void) {
+  
+  lval* v;
+  
+#ifndef VHISP_MALLOC
+  if (!lnursery.start) {
+    lnursery.start = malloc(LNURSERY_SIZE);
+    lnursery.bump = lnursery.start;
+    lnursery.end = lnursery.start + LNURSERY_SIZE;
+  }
+  if (lnursery.bump + sizeof(lval) <= lnursery.end) {
+    v = (lval*)lnursery.bump;
+    lnursery.bump += sizeof(lval);
+    lnursery.live++;
+    lnursery.allocs++;
+    lheap[LHEAP_NODE].allocs++;
+    lheap[LHEAP_NODE].live++;
+    v->flags = 0;
+    return v;
+  }
+#endif
+  
+  v = lheap_alloc(LHEAP_NODE);
+  v->flags = 0;
+  return v;
+}
+
+void lcode_forget(lval* v);
+
+void lval_free(lval* v) {
+  
+  if (v->flags & LVAL_COMPILED) { lcode_forget(v); }
+  
+  /* Nursery space is only reclaimed wholesale, by lgc_minor */
+  if (lval_in_nursery(v)) {
+    v->type = LHEAP_FREE;
+    lnursery.live--;
+    lheap[LHEAP_NODE].frees++;
+    lheap[LHEAP_NODE].live--;
+    return;
+  }
+  
+  lheap_free(LHEAP_NODE, v);
+}
+
+/* Capacity of a cell array holding n entries. Blocks must fit an */
+/* lblock, so the smallest array has room for two entries.        */
+int lcell_cap(int n) {
+  int cap = 0;
+  if (n > 0) { cap = 2; }
+  while (cap < n) { cap *= 2; }
+  return cap;
+}
+
+/* Size class for a cell array of the given capacity */
+int lcell_class(int cap) {
+  int c = 1;
+  while ((1 << c) < cap) { c++; }
+  return c > LCELL_CLASSES ? LHEAP_LARGE : c;
+}
+
+void lcell_free(lval** cell, int n) {
+  
+  if (n == 0) { return; }
+  
+  int c = lcell_class(lcell_cap(n));
+  if (c == LHEAP_LARGE) {
+    lheap[c].frees++;
+    lheap[c].live--;
+    free(cell);
+    return;
+  }
+  lheap_free(c, cell);
+}
+
+/* Resizes a cell array holding old_n entries so it can hold new_n */
+lval** lcell_resize(lval** cell, int old_n, int new_n) {
+  
+  int old_cap = lcell_cap(old_n);
+  int new_cap = lcell_cap(new_n);
+  if (old_cap == new_cap) { return cell; }
+  
+  int old_c = lcell_class(old_cap);
+  int new_c = lcell_class(new_cap);
+  
+  /* Large arrays are resized in place by the system allocator */
+  if (old_c == LHEAP_LARGE && new_c == LHEAP_LARGE) {
+    return realloc(cell, sizeof(lval*) * new_cap);
+  }
+  
+  lval** x = NULL;
+  if (new_c == LHEAP_LARGE) {
+    lheap[new_c].allocs++;
+    lheap[new_c].live++;
+    x = malloc(sizeof(lval*) * new_cap);
+  } else if (new_n > 0) {
+    x = lheap_alloc(new_c);
+  }
+  
+  if (old_n > 0 && new_n > 0) {
+    memcpy(x, cell, sizeof(lval*) * (old_n < new_n ? old_n : new_n));
+  }
+  lcell_free(cell, old_n);
+  return x;
+}
+
+lval** lcell_alloc(int n) {
+  return lcell_resize(NULL, 0, n);
+}
+
+/* Small integers are stored directly in the pointer word rather than  */
+/* on the heap. Such an lval* has its low bit set and holds the number */
+/* shifted up by one. Only numbers outside that range are boxed.       */
+
+#define LVAL_FIX_MIN (LONG_MIN >> 1)
+#define LVAL_FIX_MAX (LONG_MAX >> 1)
+
+int lval_is_fix(lval* v) {
+  return (uintptr_t)v & 1;
+}
+
+int lval_type(lval* v) {
+  return lval_is_fix(v) ? LVAL_NUM : v->type;
+}
+
+long lval_as_num(lval* v) {
+  return lval_is_fix(v) ? (long)((intptr_t)v >> 1) : v->num;
+}
+
+/* Write Barrier */
+
+/* Between minor collections the only references into the nursery     */
+/* that are not themselves in the nursery are old nodes and env slots  */
+/* that had a nursery value stored into them. Every such store goes    */
+/* through these barriers, which record the old node or the slot.      */
+
+typedef struct {
+  lenv* env;
+  int slot;
+} lslot;
+
+_Thread_local struct {
+  lval** nodes;
+  int node_count;
+  int node_cap;
+  lslot* slots;
+  int slot_count;
+  int slot_cap;
+} lremembered = { NULL, 0, 0, NULL, 0, 0 };
+
+void lgc_remember(lval* parent) {
+  
+  if (lval_in_nursery(parent) || (parent->flags & LGC_REMEMBERED)) { return; }
+  
+  parent->flags |= LGC_REMEMBERED;
+  if (lremembered.node_count == lremembered.node_cap) {
+    lremembered.node_cap = lremembered.node_cap ? lremembered.node_cap * 2 : 64;
+    lremembered.nodes = realloc(lremembered.nodes,
+      sizeof(lval*) * lremembered.node_cap);
+  }
+  lremembered.nodes[lremembered.node_count++] = parent;
+}
+
+void lgc_barrier(lval* parent, lval* child) {
+  if (lval_is_fix(child) || !lval_in_nursery(child)) { return; }
+  lgc_remember(parent);
+}
+
+void lgc_barrier_env(lenv* e, int slot, lval* v) {
+  
+  if (lval_is_fix(v) || !lval_in_nursery(v)) { return; }
+  
+  if (lremembered.slot_count == lremembered.slot_cap) {
+    lremembered.slot_cap = lremembered.slot_cap ? lremembered.slot_cap * 2 : 64;
+    lremembered.slots = realloc(lremembered.slots,
+      sizeof(lslot) * lremembered.slot_cap);
+  }
+  lslot s = { e, slot };
+  lremembered.slots[lremembered.slot_count++] = s;
+}
+
 lval* lval_num(long x) {
-  lval* v = malloc(sizeof(lval));
+  if (x >= LVAL_FIX_MIN && x <= LVAL_FIX_MAX) {
+    return (lval*)(((uintptr_t)x << 1) | 1);
+  }
+  lval* v = lval_alloc();
   v->type = LVAL_NUM;
+  v->refs = 1;
   v->num = x;
   return v;
 }
 
 lval* lval_err(char* fmt, ...) {
-  lval* v = malloc(sizeof(lval));
+  lval* v = lval_alloc();
   v->type = LVAL_ERR;
+  v->refs = 1;
   
   /* Create a va list and initialize it */
   va_list va;
@@ -59,82 +539,223 @@ lval* lval_err(char* fmt, ...) {
 }
 
 lval* lval_sym(char* s) {
-  lval* v = malloc(sizeof(lval));
+  lval* v = lval_alloc();
   v->type = LVAL_SYM;
-  v->sym = malloc(strlen(s) + 1);
-  strcpy(v->sym, s);
+  v->refs = 1;
+  v->sym = lsym_intern(s);
+  v->slot = -1;
+  v->depth = -1;
   return v;
 }
 
-lval* lval_fun(lbuiltin func) {
-  lval* v = malloc(sizeof(lval));
+lval* lval_fun(lprim* func) {
+  lval* v = lval_alloc();
   v->type = LVAL_FUN;
+  v->refs = 1;
   v->fun = func;
   return v;
 }
 
+lenv* lenv_ref(lenv* e);
+void lenv_release(lenv* e);
+
+/* A lambda holds the Q-Expression {formals body} and the environment */
+/* it was made in. An old lambda may reach the nursery through the    */
+/* frames it closes over as well as its code, so it is always         */
+/* remembered.                                                        */
+lval* lval_lambda(lval* code, lenv* env) {
+  lval* v = lval_alloc();
+  v->type = LVAL_LAMBDA;
+  v->refs = 1;
+  v->code = code;
+  v->env = lenv_ref(env);
+  lgc_remember(v);
+  return v;
+}
+
 lval* lval_sexpr(void) {
-  lval* v = malloc(sizeof(lval));
+  lval* v = lval_alloc();
   v->type = LVAL_SEXPR;
+  v->refs = 1;
   v->count = 0;
   v->cell = NULL;
   return v;
 }
 
 lval* lval_qexpr(void) {
-  lval* v = malloc(sizeof(lval));
+  lval* v = lval_alloc();
   v->type = LVAL_QEXPR;
+  v->refs = 1;
   v->count = 0;
   v->cell = NULL;
   return v;
 }
 
+lval* lval_ref(lval* v) {
+  if (lval_is_fix(v)) { return v; }
+  v->refs++;
+  return v;
+}
+
+/* Deferred Freeing */
+
+/* Dropping the last reference to a list frees its node at once but    */
+/* only queues its cells, so freeing a huge or deeply nested value     */
+/* never stalls the caller. lfree_slice releases queued cells until    */
+/* the queue is empty or the per-slice budget is spent. The REPL runs  */
+/* a slice after each evaluation and lval_eval runs one whenever the   */
+/* backlog grows too large, so reclamation always keeps moving.        */
+
+#define LFREE_BUDGET_US 500
+#define LFREE_BACKLOG 65536
+
+typedef struct {
+  lval** cell;
+  int count;
+  int next;
+  int raw;
+} lfree_entry;
+
+_Thread_local struct {
+  lfree_entry* queue;
+  int count;
+  int cap;
+  long pending;
+  long budget;
+  long slices;
+  long released;
+  long total_ns;
+  long max_ns;
+} lfree = { NULL, 0, 0, 0, LFREE_BUDGET_US, 0, 0, 0, 0 };
+
+/* Queues the cells of a dead list. Raw arrays came from malloc */
+/* rather than lcell_alloc and may contain NULL entries.        */
+void lfree_push(lval** cell, int count, int raw) {
+  
+  if (count == 0) { return; }
+  
+  if (lfree.count == lfree.cap) {
+    lfree.cap = lfree.cap ? lfree.cap * 2 : 64;
+    lfree.queue = realloc(lfree.queue, sizeof(lfree_entry) * lfree.cap);
+  }
+  lfree_entry q = { cell, count, 0, raw };
+  lfree.queue[lfree.count++] = q;
+  lfree.pending += count;
+}
+
 void lval_del(lval* v) {
 
+  /* Only free once the last reference is dropped */
+  if (lval_is_fix(v)) { return; }
+  if (--v->refs > 0) { return; }
+
   switch (v->type) {
     case LVAL_NUM: break;
     case LVAL_FUN: break;
     case LVAL_ERR: free(v->err); break;
-    case LVAL_SYM: free(v->sym); break;
+    case LVAL_BIG: free(v->digits); break;
+    case LVAL_SYM: break;
+    case LVAL_LAMBDA:
+      lval_del(v->code);
+      lenv_release(v->env);
+    break;
     case LVAL_QEXPR:
     case LVAL_SEXPR:
-      for (int i = 0; i < v->count; i++) {
-        lval_del(v->cell[i]);
-      }
-      free(v->cell);
+      /* Children are released later, a slice at a time */
+      lfree_push(v->cell, v->count, 0);
     break;
   }
   
-  free(v);
+  lval_free(v);
+}
+
+long lclock_ns(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1000000000L + t.tv_nsec;
+}
+
+void lfree_slice(void) {
+  
+  if (lfree.count == 0) { return; }
+  
+  long start = lclock_ns();
+  long n = 0;
+  
+  /* Work from the top of the queue so it stays shallow */
+  while (lfree.count > 0) {
+    lfree_entry* q = &lfree.queue[lfree.count-1];
+    
+    if (q->next == q->count) {
+      if (q->raw) { free(q->cell); } else { lcell_free(q->cell, q->count); }
+      lfree.count--;
+      continue;
+    }
+    
+    /* Releasing x may queue more cells and move the queue */
+    lval* x = q->cell[q->next++];
+    lfree.pending--;
+    if (x) { lval_del(x); }
+    
+    /* Reading the clock is not free, so only check it now and then */
+    if ((++n & 63) == 0 && lclock_ns() - start > lfree.budget * 1000) {
+      break;
+    }
+  }
+  
+  long t = lclock_ns() - start;
+  lfree.slices++;
+  lfree.released += n;
+  lfree.total_ns += t;
+  if (t > lfree.max_ns) { lfree.max_ns = t; }
 }
 
+/* Releases everything queued, however long it takes */
+void lfree_drain(void) {
+  while (lfree.count > 0) { lfree_slice(); }
+}
+
+/* Copies the top level of v. Children are shared rather than copied */
+/* since they stay immutable for as long as both lists hold them.     */
 lval* lval_copy(lval* v) {
 
-  lval* x = malloc(sizeof(lval));
+  /* Immediates are their own copy */
+  if (lval_is_fix(v)) { return v; }
+
+  /* Lambdas are never changed in place */
+  if (v->type == LVAL_LAMBDA) { return lval_lambda(lval_ref(v->code), v->env); }
+
+  lval* x = lval_alloc();
   x->type = v->type;
+  x->refs = 1;
   
   switch (v->type) {
     
-    /* Copy Functions and Numbers Directly */
+    /* Copy Functions, Numbers and interned Symbols Directly */
     case LVAL_FUN: x->fun = v->fun; break;
     case LVAL_NUM: x->num = v->num; break;
+    case LVAL_SYM: x->sym = v->sym; x->slot = v->slot; x->depth = v->depth; break;
     
     /* Copy Strings using malloc and strcpy */
     case LVAL_ERR:
       x->err = malloc(strlen(v->err) + 1);
       strcpy(x->err, v->err); break;
-      
-    case LVAL_SYM:
-      x->sym = malloc(strlen(v->sym) + 1);
-      strcpy(x->sym, v->sym); break;
     
-    /* Copy Lists by copying each sub-expression */
+    /* Copy the digits of bignums */
+    case LVAL_BIG:
+      x->size = v->size;
+      x->digits = malloc(sizeof(uint32_t) * abs(v->size));
+      memcpy(x->digits, v->digits, sizeof(uint32_t) * abs(v->size));
+    break;
+    
+    /* Copy Lists by taking a reference to each sub-expression */
     case LVAL_SEXPR:
     case LVAL_QEXPR:
       x->count = v->count;
-      x->cell = malloc(sizeof(lval*) * x->count);
+      x->cell = lcell_alloc(x->count);
       for (int i = 0; i < x->count; i++) {
-        x->cell[i] = lval_copy(v->cell[i]);
+        x->cell[i] = lval_ref(v->cell[i]);
+        lgc_barrier(x, x->cell[i]);
       }
     break;
   }
@@ -142,59 +763,128 @@ lval* lval_copy(lval* v) {
   return x;
 }
 
+/* Returns a value that is safe to mutate, copying v only if it is shared */
+lval* lval_own(lval* v) {
+  if (lval_is_fix(v)) { return v; }
+  if (v->refs == 1) {
+    /* The caller is about to change v, so any code compiled from it */
+    /* no longer matches                                             */
+    if (v->flags & LVAL_COMPILED) { lcode_forget(v); }
+    return v;
+  }
+  lval* x = lval_copy(v);
+  lval_del(v);
+  return x;
+}
+
 lval* lval_add(lval* v, lval* x) {
+  v->cell = lcell_resize(v->cell, v->count, v->count+1);
   v->count++;
-  v->cell = realloc(v->cell, sizeof(lval*) * v->count);
   v->cell[v->count-1] = x;
+  lgc_barrier(v, x);
   return v;
 }
 
-lval* lval_join(lval* x, lval* y) {  
-  for (int i = 0; i < y->count; i++) {
-    x = lval_add(x, y->cell[i]);
+/* Builds a list of the given type sharing n values */
+lval* lval_list(int type, lval** xs, int n) {
+  lval* v = lval_sexpr();
+  v->type = type;
+  v->cell = lcell_alloc(n);
+  v->count = n;
+  for (int i = 0; i < n; i++) {
+    v->cell[i] = lval_ref(xs[i]);
+    lgc_barrier(v, xs[i]);
   }
-  free(y->cell);
-  free(y);  
-  return x;
+  return v;
 }
 
 lval* lval_pop(lval* v, int i) {
   lval* x = v->cell[i];  
   memmove(&v->cell[i], &v->cell[i+1],
     sizeof(lval*) * (v->count-i-1));  
-  v->count--;  
-  v->cell = realloc(v->cell, sizeof(lval*) * v->count);
+  v->cell = lcell_resize(v->cell, v->count, v->count-1);
+  v->count--;
   return x;
 }
 
 lval* lval_take(lval* v, int i) {
-  lval* x = lval_pop(v, i);
+  
+  /* A sole owner hands the child over rather than referencing it, */
+  /* as the list's own reference would only be dropped in a slice  */
+  if (v->refs == 1) {
+    lval* x = v->cell[i];
+    v->cell[i] = NULL;
+    lval_del(v);
+    return x;
+  }
+  
+  lval* x = lval_ref(v->cell[i]);
   lval_del(v);
   return x;
 }
 
-void lval_print(lval* v);
+char* lbig_string(lval* v);
 
-void lval_print_expr(lval* v, char open, char close) {
-  putchar(open);
-  for (int i = 0; i < v->count; i++) {
-    lval_print(v->cell[i]);    
-    if (i != (v->count-1)) {
-      putchar(' ');
+void lval_print_atom(lval* v) {
+  switch (lval_type(v)) {
+    case LVAL_FUN:   printf("<function>"); break;
+    case LVAL_NUM:   printf("%li", lval_as_num(v)); break;
+    case LVAL_BIG: {
+      char* s = lbig_string(v);
+      printf("%s", s);
+      free(s);
     }
+    break;
+    case LVAL_ERR:   printf("Error: %s", v->err); break;
+    case LVAL_SYM:   printf("%s", v->sym); break;
   }
-  putchar(close);
 }
 
+/* Open lists are kept on a heap stack so printing deeply nested */
+/* data does not recurse on the C stack. A lambda prints as the  */
+/* expression that made it, with its code as the open list.      */
 void lval_print(lval* v) {
-  switch (v->type) {
-    case LVAL_FUN:   printf("<function>"); break;
-    case LVAL_NUM:   printf("%li", v->num); break;
-    case LVAL_ERR:   printf("Error: %s", v->err); break;
-    case LVAL_SYM:   printf("%s", v->sym); break;
-    case LVAL_SEXPR: lval_print_expr(v, '(', ')'); break;
-    case LVAL_QEXPR: lval_print_expr(v, '{', '}'); break;
+  
+  struct { lval* v; int i; char close; }* open = NULL;
+  int count = 0, cap = 0;
+  
+  while (v) {
+    
+    int type = lval_type(v);
+    if (type == LVAL_SEXPR || type == LVAL_QEXPR || type == LVAL_LAMBDA) {
+      putchar(type == LVAL_QEXPR ? '{' : '(');
+      if (type == LVAL_LAMBDA) {
+        printf("\\ ");
+        v = v->code;
+      }
+      if (count == cap) {
+        cap = cap ? cap * 2 : 16;
+        open = realloc(open, sizeof(*open) * cap);
+      }
+      open[count].v = v;
+      open[count].i = 0;
+      open[count].close = type == LVAL_QEXPR ? '}' : ')';
+      count++;
+    } else {
+      lval_print_atom(v);
+    }
+    
+    /* Find the next cell, closing every list that is finished */
+    v = NULL;
+    while (count > 0) {
+      lval* l = open[count-1].v;
+      int i = open[count-1].i++;
+      if (i < l->count) {
+        if (i > 0) { putchar(' '); }
+        v = l->cell[i];
+        break;
+      }
+      putchar(open[count-1].close);
+      count--;
+    }
   }
+  
+  free(open);
 }
 
 void lval_println(lval* v) { lval_print(v); putchar('\n'); }
@@ -202,7 +892,9 @@ void lval_println(lval* v) { lval_print(v); putchar('\n'); }
 char* ltype_name(int t) {
   switch(t) {
     case LVAL_FUN: return "Function";
+    case LVAL_LAMBDA: return "Function";
     case LVAL_NUM: return "Number";
+    case LVAL_BIG: return "Number";
     case LVAL_ERR: return "Error";
     case LVAL_SYM: return "Symbol";
     case LVAL_SEXPR: return "S-Expression";
@@ -211,404 +903,4406 @@ char* ltype_name(int t) {
   }
 }
 
-/* Lisp Environment */
+/* Bignums */
 
-struct lenv {
-  int count;
-  char** syms;
-  lval** vals;
-};
+/* Integers outside the range of a long are LVAL_BIG nodes holding a    */
+/* magnitude of size 32-bit digits, least significant first, with size */
+/* negative for negative numbers. Arithmetic only makes one when a      */
+/* result does not fit a long, so every number that does stays an       */
+/* immediate or a boxed long and never reaches the code below.          */
+/*                                                                      */
+/* The routines work on lbig, a digit array with its length and sign,   */
+/* and lval_big turns one back into a value. Long products use          */
+/* Karatsuba's method; decimal conversion splits the number by a power  */
+/* of ten near its square root and converts both halves recursively.    */
 
-lenv* lenv_new(void) {
+typedef struct {
+  uint32_t* d;
+  int n;
+  int neg;
+} lbig;
 
-  /* Initialize struct */
-  lenv* e = malloc(sizeof(lenv));
-  e->count = 0;
-  e->syms = NULL;
-  e->vals = NULL;
-  return e;
-  
+/* Digit counts below which the simple methods are faster */
+#define LBIG_KARATSUBA 32
+#define LBIG_DECIMAL 16
+
+/* Results of ** beyond this many bits are refused */
+#define LBIG_MAX_BITS (1L << 24)
+
+/* Length of the magnitude d[0..n) without leading zeros */
+int lmag_len(uint32_t* d, int n) {
+  while (n > 0 && d[n-1] == 0) { n--; }
+  return n;
 }
 
-void lenv_del(lenv* e) {
-  
-  /* Iterate over all items in environment deleting them */
-  for (int i = 0; i < e->count; i++) {
-    free(e->syms[i]);
-    lval_del(e->vals[i]);
+int lmag_cmp(uint32_t* a, int an, uint32_t* b, int bn) {
+  if (an != bn) { return an < bn ? -1 : 1; }
+  for (int i = an - 1; i >= 0; i--) {
+    if (a[i] != b[i]) { return a[i] < b[i] ? -1 : 1; }
   }
-  
-  /* Free allocated memory for lists */
-  free(e->syms);
-  free(e->vals);
-  free(e);
+  return 0;
 }
 
-lval* lenv_get(lenv* e, lval* k) {
-  
-  /* Iterate over all items in environment */
-  for (int i = 0; i < e->count; i++) {
-    /* Check if the stored string matches the symbol string */
-    /* If it does, return a copy of the value */
-    if (strcmp(e->syms[i], k->sym) == 0) {
-      return lval_copy(e->vals[i]);
+/* r[0..rn) += a[0..an), where an <= rn and the sum fits */
+void lmag_addto(uint32_t* r, int rn, uint32_t* a, int an) {
+  uint64_t c = 0;
+  int i = 0;
+  for (; i < an; i++) {
+    c += (uint64_t)r[i] + a[i];
+    r[i] = (uint32_t)c;
+    c >>= 32;
+  }
+  for (; c && i < rn; i++) {
+    c += r[i];
+    r[i] = (uint32_t)c;
+    c >>= 32;
+  }
+}
+
+/* r[0..rn) -= a[0..an), where r is at least a */
+void lmag_subfrom(uint32_t* r, int rn, uint32_t* a, int an) {
+  uint64_t b = 0;
+  int i = 0;
+  for (; i < an; i++) {
+    uint64_t t = (uint64_t)r[i] - a[i] - b;
+    r[i] = (uint32_t)t;
+    b = t >> 63;
+  }
+  for (; b && i < rn; i++) {
+    uint64_t t = (uint64_t)r[i] - b;
+    r[i] = (uint32_t)t;
+    b = t >> 63;
+  }
+}
+
+void lmag_school(uint32_t* r, int rn, uint32_t* a, int an, uint32_t* b, int bn) {
+  for (int i = 0; i < an; i++) {
+    uint64_t c = 0;
+    for (int j = 0; j < bn; j++) {
+      c += (uint64_t)a[i] * b[j] + r[i+j];
+      r[i+j] = (uint32_t)c;
+      c >>= 32;
+    }
+    for (int k = i + bn; c && k < rn; k++) {
+      c += r[k];
+      r[k] = (uint32_t)c;
+      c >>= 32;
     }
   }
-  /* If no symbol found return error */
-  return lval_err("Unbound Symbol '%s'", k->sym);
 }
 
-void lenv_put(lenv* e, lval* k, lval* v) {
+/* r[0..rn) += a * b, where rn >= an + bn. With a = a1 B^m + a0 and  */
+/* b = b1 B^m + b0 the middle term a1 b0 + a0 b1 is found from one   */
+/* product, (a0 + a1)(b0 + b1) - a0 b0 - a1 b1, so three half-size   */
+/* products replace four.                                           */
+void lmag_muladd(uint32_t* r, int rn, uint32_t* a, int an, uint32_t* b, int bn) {
   
-  /* Iterate over all items in environment */
-  /* This is to see if variable already exists */
-  for (int i = 0; i < e->count; i++) {
+  if (an < bn) {
+    uint32_t* t = a; a = b; b = t;
+    int tn = an; an = bn; bn = tn;
+  }
+  if (bn < LBIG_KARATSUBA) {
+    lmag_school(r, rn, a, an, b, bn);
+    return;
+  }
   
-    /* If variable is found delete item at that position */
-    /* And replace with variable supplied by user */
-    if (strcmp(e->syms[i], k->sym) == 0) {
-      lval_del(e->vals[i]);
-      e->vals[i] = lval_copy(v);
-      return;
+  /* A much shorter b is multiplied into slices of a its own size */
+  int m = (an + 1) / 2;
+  if (bn <= m) {
+    for (int i = 0; i < an; i += bn) {
+      int len = an - i < bn ? an - i : bn;
+      lmag_muladd(r + i, rn - i, a + i, len, b, bn);
     }
+    return;
   }
   
-  /* If no existing entry found allocate space for new entry */
-  e->count++;
-  e->vals = realloc(e->vals, sizeof(lval*) * e->count);
-  e->syms = realloc(e->syms, sizeof(char*) * e->count);
+  int a0n = lmag_len(a, m), a1n = an - m;
+  int b0n = lmag_len(b, m), b1n = bn - m;
+  int sn = m + 1;
   
-  /* Copy contents of lval and symbol string into new location */
-  e->vals[e->count-1] = lval_copy(v);
-  e->syms[e->count-1] = malloc(strlen(k->sym)+1);
-  strcpy(e->syms[e->count-1], k->sym);
+  uint32_t* t = calloc(6 * sn + 2 * m, sizeof(uint32_t));
+  uint32_t* sa = t;
+  uint32_t* sb = sa + sn;
+  uint32_t* z1 = sb + sn;
+  uint32_t* z0 = z1 + 2 * sn;
+  uint32_t* z2 = z0 + 2 * m;
+  
+  memcpy(sa, a, sizeof(uint32_t) * a0n);
+  lmag_addto(sa, sn, a + m, a1n);
+  memcpy(sb, b, sizeof(uint32_t) * b0n);
+  lmag_addto(sb, sn, b + m, b1n);
+  
+  lmag_muladd(z0, 2 * m, a, a0n, b, b0n);
+  lmag_muladd(z2, a1n + b1n, a + m, a1n, b + m, b1n);
+  lmag_muladd(z1, 2 * sn, sa, lmag_len(sa, sn), sb, lmag_len(sb, sn));
+  lmag_subfrom(z1, 2 * sn, z0, 2 * m);
+  lmag_subfrom(z1, 2 * sn, z2, a1n + b1n);
+  
+  lmag_addto(r, rn, z0, lmag_len(z0, 2 * m));
+  lmag_addto(r + m, rn - m, z1, lmag_len(z1, 2 * sn));
+  lmag_addto(r + 2 * m, rn - 2 * m, z2, lmag_len(z2, a1n + b1n));
+  free(t);
 }
 
-/* Builtins */
-
-#define LASSERT(args, cond, fmt, ...) \
-  if (!(cond)) { lval* err = lval_err(fmt, ##__VA_ARGS__); lval_del(args); return err; }
-
-#define LASSERT_TYPE(func, args, index, expect) \
-  LASSERT(args, args->cell[index]->type == expect, \
-    "Function '%s' passed incorrect type for argument %i. Got %s, Expected %s.", \
-    func, index, ltype_name(args->cell[index]->type), ltype_name(expect))
-
-#define LASSERT_NUM(func, args, num) \
-  LASSERT(args, args->count == num, \
-    "Function '%s' passed incorrect number of arguments. Got %i, Expected %i.", \
-    func, args->count, num)
-
-#define LASSERT_NOT_EMPTY(func, args, index) \
-  LASSERT(args, args->cell[index]->count != 0, \
-    "Function '%s' passed {} for argument %i.", func, index);
-
+/* Long division of u[0..m) by v[0..n), where m >= n and v has no */
+/* leading zero, into quotient q[0..m-n] and remainder r[0..n).  */
+/* This is Knuth's Algorithm D.                                 */
+void lmag_divmod(uint32_t* q, uint32_t* r, uint32_t* u, int m, uint32_t* v, int n) {
+  
+  if (n == 1) {
+    uint64_t k = 0;
+    for (int j = m - 1; j >= 0; j--) {
+      uint64_t t = (k << 32) | u[j];
+      q[j] = (uint32_t)(t / v[0]);
+      k = t % v[0];
+    }
+    r[0] = (uint32_t)k;
+    return;
+  }
+  
+  /* Shift both so the divisor's top digit has its high bit set, */
+  /* which keeps each estimated quotient digit at most 2 too big */
+  int s = __builtin_clz(v[n-1]);
+  uint32_t* vn = malloc(sizeof(uint32_t) * n);
+  uint32_t* un = malloc(sizeof(uint32_t) * (m + 1));
+  for (int i = n - 1; i > 0; i--) {
+    vn[i] = (v[i] << s) | (uint32_t)((uint64_t)v[i-1] >> (32 - s));
+  }
+  vn[0] = v[0] << s;
+  un[m] = (uint32_t)((uint64_t)u[m-1] >> (32 - s));
+  for (int i = m - 1; i > 0; i--) {
+    un[i] = (u[i] << s) | (uint32_t)((uint64_t)u[i-1] >> (32 - s));
+  }
+  un[0] = u[0] << s;
+  
+  for (int j = m - n; j >= 0; j--) {
+    
+    /* Estimate the digit from the top two of the remainder */
+    uint64_t top = ((uint64_t)un[j+n] << 32) | un[j+n-1];
+    uint64_t qhat = top / vn[n-1];
+    uint64_t rhat = top % vn[n-1];
+    while (qhat >> 32 || qhat * vn[n-2] > ((rhat << 32) | un[j+n-2])) {
+      qhat--;
+      rhat += vn[n-1];
+      if (rhat >> 32) { break; }
+    }
+    
+    /* Subtract qhat times the divisor */
+    int64_t k = 0, t;
+    for (int i = 0; i < n; i++) {
+      uint64_t p = qhat * vn[i];
+      t = (int64_t)un[i+j] - k - (int64_t)(p & 0xffffffff);
+      un[i+j] = (uint32_t)t;
+      k = (int64_t)(p >> 32) - (t >> 32);
+    }
+    t = (int64_t)un[j+n] - k;
+    un[j+n] = (uint32_t)t;
+    q[j] = (uint32_t)qhat;
+    
+    /* The estimate was one too big, so add the divisor back */
+    if (t < 0) {
+      q[j]--;
+      uint64_t c = 0;
+      for (int i = 0; i < n; i++) {
+        c += (uint64_t)un[i+j] + vn[i];
+        un[i+j] = (uint32_t)c;
+        c >>= 32;
+      }
+      un[j+n] += (uint32_t)c;
+    }
+  }
+  
+  for (int i = 0; i < n; i++) {
+    r[i] = (un[i] >> s) | (uint32_t)((uint64_t)un[i+1] << (32 - s));
+  }
+  free(vn);
+  free(un);
+}
+
+lbig lbig_alloc(int n) {
+  lbig x = { calloc(n ? n : 1, sizeof(uint32_t)), n, 0 };
+  return x;
+}
+
+lbig lbig_copy(lbig a) {
+  lbig x = lbig_alloc(a.n);
+  memcpy(x.d, a.d, sizeof(uint32_t) * a.n);
+  x.neg = a.neg;
+  return x;
+}
+
+/* Views the number v as an lbig without copying. A long is written */
+/* into buf, which needs room for two digits.                       */
+lbig lbig_view(lval* v, uint32_t* buf) {
+  lbig x;
+  if (lval_type(v) == LVAL_BIG) {
+    x.d = v->digits;
+    x.n = abs(v->size);
+    x.neg = v->size < 0;
+    return x;
+  }
+  long y = lval_as_num(v);
+  unsigned long m = y < 0 ? -(unsigned long)y : (unsigned long)y;
+  buf[0] = (uint32_t)m;
+  buf[1] = (uint32_t)(m >> 32);
+  x.d = buf;
+  x.n = lmag_len(buf, 2);
+  x.neg = y < 0;
+  return x;
+}
+
+lbig lbig_from_long(long y) {
+  unsigned long m = y < 0 ? -(unsigned long)y : (unsigned long)y;
+  lbig x = lbig_alloc(2);
+  x.d[0] = (uint32_t)m;
+  x.d[1] = (uint32_t)(m >> 32);
+  x.n = lmag_len(x.d, 2);
+  x.neg = y < 0;
+  return x;
+}
+
+/* Turns x into a value, taking its digits */
+lval* lval_big(lbig x) {
+  
+  /* Anything a long can hold is stored as one */
+  if (x.n <= 2) {
+    unsigned long m = x.n == 0 ? 0 : x.d[0] | (x.n == 2 ? (unsigned long)x.d[1] << 32 : 0);
+    if (m <= (unsigned long)LONG_MAX || (x.neg && m == (unsigned long)LONG_MAX + 1)) {
+      free(x.d);
+      return lval_num(x.neg ? (long)(0 - m) : (long)m);
+    }
+  }
+  
+  lval* v = lval_alloc();
+  v->type = LVAL_BIG;
+  v->refs = 1;
+  v->digits = x.d;
+  v->size = x.neg ? -x.n : x.n;
+  return v;
+}
+
+long lbig_bits(lbig a) {
+  return a.n ? (long)(a.n - 1) * 32 + 32 - __builtin_clz(a.d[a.n-1]) : 0;
+}
+
+int lbig_cmp(lbig a, lbig b) {
+  if (a.neg != b.neg) { return a.neg ? -1 : 1; }
+  int c = lmag_cmp(a.d, a.n, b.d, b.n);
+  return a.neg ? -c : c;
+}
+
+/* a + b, or a - b if sub is set */
+lbig lbig_add(lbig a, lbig b, int sub) {
+  
+  int bneg = b.neg ^ sub;
+  if (a.neg == bneg) {
+    int n = (a.n > b.n ? a.n : b.n) + 1;
+    lbig x = lbig_alloc(n);
+    memcpy(x.d, a.d, sizeof(uint32_t) * a.n);
+    lmag_addto(x.d, n, b.d, b.n);
+    x.n = lmag_len(x.d, n);
+    x.neg = a.neg;
+    return x;
+  }
+  
+  /* With opposite signs take the smaller magnitude from the larger */
+  int c = lmag_cmp(a.d, a.n, b.d, b.n);
+  lbig hi = c >= 0 ? a : b;
+  lbig lo = c >= 0 ? b : a;
+  lbig x = lbig_alloc(hi.n);
+  memcpy(x.d, hi.d, sizeof(uint32_t) * hi.n);
+  lmag_subfrom(x.d, hi.n, lo.d, lo.n);
+  x.n = lmag_len(x.d, hi.n);
+  x.neg = x.n && (c >= 0 ? a.neg : bneg);
+  return x;
+}
+
+lbig lbig_mul(lbig a, lbig b) {
+  lbig x = lbig_alloc(a.n + b.n);
+  lmag_muladd(x.d, a.n + b.n, a.d, a.n, b.d, b.n);
+  x.n = lmag_len(x.d, a.n + b.n);
+  x.neg = x.n && a.neg != b.neg;
+  return x;
+}
+
+/* Divides a by nonzero b, truncating toward zero as C does */
+void lbig_divmod(lbig a, lbig b, lbig* q, lbig* r) {
+  if (lmag_cmp(a.d, a.n, b.d, b.n) < 0) {
+    *q = lbig_alloc(0);
+    *r = lbig_copy(a);
+    return;
+  }
+  *q = lbig_alloc(a.n - b.n + 1);
+  *r = lbig_alloc(b.n);
+  lmag_divmod(q->d, r->d, a.d, a.n, b.d, b.n);
+  q->n = lmag_len(q->d, a.n - b.n + 1);
+  r->n = lmag_len(r->d, b.n);
+  q->neg = q->n && a.neg != b.neg;
+  r->neg = r->n && a.neg;
+}
+
+/* Negates t[0..n) in two's complement */
+void lmag_negate(uint32_t* t, int n) {
+  uint64_t c = 1;
+  for (int i = 0; i < n; i++) {
+    c += (uint32_t)~t[i];
+    t[i] = (uint32_t)c;
+    c >>= 32;
+  }
+}
+
+/* Writes the low n digits of a in two's complement into t */
+void lbig_twos(lbig a, uint32_t* t, int n) {
+  for (int i = 0; i < n; i++) { t[i] = i < a.n ? a.d[i] : 0; }
+  if (a.neg) { lmag_negate(t, n); }
+}
+
+/* a & b or a | b, on the infinite two's complement forms */
+lbig lbig_logic(int and, lbig a, lbig b) {
+  int n = (a.n > b.n ? a.n : b.n) + 1;
+  lbig x = lbig_alloc(n);
+  uint32_t* t = malloc(sizeof(uint32_t) * n);
+  lbig_twos(a, x.d, n);
+  lbig_twos(b, t, n);
+  for (int i = 0; i < n; i++) { x.d[i] = and ? x.d[i] & t[i] : x.d[i] | t[i]; }
+  free(t);
+  
+  /* A negative result is turned back into a magnitude */
+  x.neg = and ? a.neg && b.neg : a.neg || b.neg;
+  if (x.neg) { lmag_negate(x.d, n); }
+  x.n = lmag_len(x.d, n);
+  return x;
+}
+
+/* a to the power y >= 0 by repeated squaring */
+lbig lbig_pow(lbig a, long y) {
+  lbig r = lbig_from_long(1);
+  lbig p = lbig_copy(a);
+  while (y > 0) {
+    if (y & 1) {
+      lbig t = lbig_mul(r, p);
+      free(r.d);
+      r = t;
+    }
+    y >>= 1;
+    if (y > 0) {
+      lbig t = lbig_mul(p, p);
+      free(p.d);
+      p = t;
+    }
+  }
+  free(p.d);
+  return r;
+}
+
+/* Reads an optionally signed run of decimal digits */
+lval* lbig_read(char* s) {
+  
+  int neg = *s == '-';
+  if (neg) { s++; }
+  int len = strlen(s);
+  
+  /* Fold in nine digits at a time, a shorter group first */
+  lbig x = lbig_alloc(len / 9 + 2);
+  x.n = 0;
+  int g = len % 9 ? len % 9 : 9;
+  for (int i = 0; i < len; i += g, g = 9) {
+    uint64_t scale = 1;
+    uint64_t c = 0;
+    for (int k = 0; k < g; k++) {
+      c = c * 10 + (s[i+k] - '0');
+      scale *= 10;
+    }
+    for (int j = 0; j < x.n; j++) {
+      c += (uint64_t)x.d[j] * scale;
+      x.d[j] = (uint32_t)c;
+      c >>= 32;
+    }
+    if (c) { x.d[x.n++] = (uint32_t)c; }
+  }
+  
+  x.neg = neg && x.n;
+  return lval_big(x);
+}
+
+/* Writes the decimal digits of the magnitude of a to out, padded with */
+/* zeros to width if that is not 0, and returns how many it wrote.     */
+/* pows[k] is 10^(9 * 2^k).                                            */
+int lbig_decimal(char* out, lbig a, int width, lbig* pows, int k) {
+  
+  /* Find the largest power at most about the square root of a */
+  while (k >= 0 && pows[k].n > (a.n + 1) / 2) { k--; }
+  
+  if (a.n <= LBIG_DECIMAL || k < 0) {
+    
+    /* Peel off nine digits at a time by dividing by 10^9 */
+    char* t = malloc(a.n * 10 + 10);
+    uint32_t* u = malloc(sizeof(uint32_t) * (a.n + 1));
+    memcpy(u, a.d, sizeof(uint32_t) * a.n);
+    int n = a.n, len = 0;
+    while (n > 0) {
+      uint64_t c = 0;
+      for (int j = n - 1; j >= 0; j--) {
+        c = (c << 32) | u[j];
+        u[j] = (uint32_t)(c / 1000000000);
+        c %= 1000000000;
+      }
+      n = lmag_len(u, n);
+      for (int d = 0; d < 9; d++) {
+        t[len++] = '0' + c % 10;
+        c /= 10;
+      }
+    }
+    while (len > 0 && t[len-1] == '0') { len--; }
+    if (len == 0) { t[len++] = '0'; }
+    
+    int w = 0;
+    for (; w + len < width; w++) { out[w] = '0'; }
+    for (int i = 0; i < len; i++) { out[w++] = t[len-1-i]; }
+    free(t);
+    free(u);
+    return w;
+  }
+  
+  lbig q, r;
+  lbig_divmod(a, pows[k], &q, &r);
+  int digits = 9 << k;
+  int w = lbig_decimal(out, q, width ? width - digits : 0, pows, k);
+  w += lbig_decimal(out + w, r, digits, pows, k);
+  free(q.d);
+  free(r.d);
+  return w;
+}
+
+/* The decimal form of the number v, which the caller frees */
+char* lbig_string(lval* v) {
+  
+  uint32_t buf[2];
+  lbig a = lbig_view(v, buf);
+  
+  /* Square 10^9 until it reaches about the square root of a */
+  int cap = 4, k = 0;
+  lbig* pows = malloc(sizeof(lbig) * cap);
+  pows[0] = lbig_from_long(1000000000);
+  while (pows[k].n * 2 <= a.n) {
+    if (k + 1 == cap) {
+      cap *= 2;
+      pows = realloc(pows, sizeof(lbig) * cap);
+    }
+    pows[k+1] = lbig_mul(pows[k], pows[k]);
+    k++;
+  }
+  
+  char* s = malloc(a.n * 10 + 2);
+  int n = 0;
+  if (a.neg) { s[n++] = '-'; }
+  n += lbig_decimal(s + n, a, 0, pows, k);
+  s[n] = '\0';
+  
+  for (int i = 0; i <= k; i++) { free(pows[i].d); }
+  free(pows);
+  return s;
+}
+
+/* Lisp Environment */
+
+/* Open-addressing hash table with linear probing, keyed on interned */
+/* symbol pointers. Slots with a NULL symbol are empty. Capacity is    */
+/* always a power of two.                                              */
+
+#define LENV_MIN_CAP 16
+
+void lgc_add_env(lenv* e);
+void lgc_remove_env(lenv* e);
+
+/* Values live in a slot array, in the order their names were first */
+/* seen, and a hash index maps each interned name to its slot. Slots */
+/* are never moved or reused, so a symbol resolved to a slot stays   */
+/* valid for as long as its environment; a slot whose name has no    */
+/* value holds NULL.                                                 */
+
+/* Versions are drawn from one counter shared by every environment, */
+/* so an environment and version pair is never seen twice even when */
+/* a freed environment's memory is reused.                          */
+
+long lenv_versions = 0;
+
+/* A lambda is called in a frame whose parent is the environment the */
+/* lambda was made in, and names are looked up along that chain. A   */
+/* frame has a fixed slot for each parameter and no index, and is    */
+/* reference counted by the call and any lambdas made within it. The */
+/* top-level environment has no parent and lives until deleted.      */
+
+struct lenv {
+  int count;
+  int cap;
+  char** syms;
+  int* slots;
+  lval** vals;
+  char** names;
+  int slot_count;
+  int slot_cap;
+  long version;
+  lenv* par;
+  int refs;
+};
+
+unsigned long lptr_hash(void* p) {
+  /* Mix the pointer bits; interned names are unique so this is enough */
+  unsigned long h = (unsigned long)p;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdUL;
+  h ^= h >> 33;
+  return h;
+}
+
+lenv* lenv_new(void) {
+
+  /* Initialize struct */
+  lenv* e = malloc(sizeof(lenv));
+  e->count = 0;
+  e->cap = LENV_MIN_CAP;
+  e->syms = calloc(e->cap, sizeof(char*));
+  e->slots = calloc(e->cap, sizeof(int));
+  e->slot_count = 0;
+  e->slot_cap = LENV_MIN_CAP;
+  e->vals = calloc(e->slot_cap, sizeof(lval*));
+  e->names = calloc(e->slot_cap, sizeof(char*));
+  e->version = ++lenv_versions;
+  e->par = NULL;
+  e->refs = 1;
+  lgc_add_env(e);
+  return e;
+  
+}
+
+/* Makes a frame under par binding each symbol of formals to one of the */
+/* borrowed values in argv. The values come first in the allocation,   */
+/* followed by their names and the frame itself.                       */
+lenv* lenv_frame(lenv* par, lval* formals, lval** argv) {
+  
+  int n = formals->count;
+  lval** vals = malloc(n * (sizeof(lval*) + sizeof(char*)) + sizeof(lenv));
+  char** names = (char**)(vals + n);
+  lenv* e = (lenv*)(names + n);
+  
+  e->count = 0;
+  e->cap = 0;
+  e->syms = NULL;
+  e->slots = NULL;
+  e->vals = vals;
+  e->names = names;
+  e->slot_count = n;
+  e->slot_cap = n;
+  e->version = ++lenv_versions;
+  e->par = lenv_ref(par);
+  e->refs = 1;
+  
+  for (int i = 0; i < n; i++) {
+    names[i] = formals->cell[i]->sym;
+    vals[i] = lval_ref(argv[i]);
+  }
+  return e;
+}
+
+lenv* lenv_ref(lenv* e);
+void lenv_release(lenv* e);
+
+/* Binds frame e, whose call is over and which nothing else holds, for */
+/* a call of the same arity under par, consuming the values in argv    */
+void lenv_rebind(lenv* e, lenv* par, lval* formals, lval** argv) {
+  
+  for (int i = 0; i < e->slot_count; i++) {
+    lval_del(e->vals[i]);
+    e->names[i] = formals->cell[i]->sym;
+    e->vals[i] = argv[i];
+  }
+  
+  par = lenv_ref(par);
+  lenv_release(e->par);
+  e->par = par;
+  e->version = ++lenv_versions;
+}
+
+lenv* lenv_ref(lenv* e) {
+  if (e->par) { e->refs++; }
+  return e;
+}
+
+/* Drops a reference to a frame. A dead frame's values are queued for */
+/* release, which frees the whole allocation once they are done, and  */
+/* its parent loses the reference the frame held.                     */
+void lenv_release(lenv* e) {
+  while (e->par && --e->refs == 0) {
+    lenv* par = e->par;
+    if (e->slot_count > 0) {
+      lfree_push(e->vals, e->slot_count, 1);
+    } else {
+      free(e->vals);
+    }
+    e = par;
+  }
+}
+
+/* Returns the first bound slot at or after i, or -1 if there is none */
+int lenv_next(lenv* e, int i) {
+  for (; i < e->slot_count; i++) {
+    if (e->vals[i]) { return i; }
+  }
+  return -1;
+}
+
+/* Deletes a top-level environment and releases its values. Lambdas */
+/* and frames among them still refer to e, so they are all released  */
+/* before e itself is freed.                                          */
+void lenv_del(lenv* e) {
+  
+  lgc_remove_env(e);
+  
+  /* Only the first slot_count entries of the array were ever set. */
+  /* The drain is unbounded because releasing a lambda walks up its */
+  /* frames and reads e, which is freed below. An environment only  */
+  /* goes away once its session ends, where no pause is noticed.    */
+  if (e->slot_count > 0) {
+    lfree_push(e->vals, e->slot_count, 1);
+    lfree_drain();
+  } else {
+    free(e->vals);
+  }
+  
+  free(e->syms);
+  free(e->slots);
+  free(e->names);
+  free(e);
+}
+
+/* Returns the index entry holding sym, or the empty one where it would go */
+int lenv_find(lenv* e, char* sym) {
+  int mask = e->cap - 1;
+  int i = lptr_hash(sym) & mask;
+  while (e->syms[i] && e->syms[i] != sym) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void lenv_grow(lenv* e) {
+  
+  int old_cap = e->cap;
+  char** old_syms = e->syms;
+  int* old_slots = e->slots;
+  
+  e->cap *= 2;
+  e->syms = calloc(e->cap, sizeof(char*));
+  e->slots = calloc(e->cap, sizeof(int));
+  
+  /* Reinsert every entry; the slots themselves stay where they are */
+  for (int i = 0; i < old_cap; i++) {
+    if (!old_syms[i]) { continue; }
+    int j = lenv_find(e, old_syms[i]);
+    e->syms[j] = old_syms[i];
+    e->slots[j] = old_slots[i];
+  }
+  
+  free(old_syms);
+  free(old_slots);
+}
+
+/* Returns the slot for sym, or -1 if it has none */
+int lenv_slot(lenv* e, char* sym) {
+  
+  /* Frames have a few parameters, which are quicker to scan than hash */
+  if (!e->syms) {
+    for (int i = 0; i < e->slot_count; i++) {
+      if (e->names[i] == sym) { return i; }
+    }
+    return -1;
+  }
+  
+  int i = lenv_find(e, sym);
+  return e->syms[i] ? e->slots[i] : -1;
+}
+
+/* Returns the slot for sym, giving it an empty one if it has none */
+int lenv_resolve(lenv* e, char* sym) {
+  
+  int i = lenv_find(e, sym);
+  if (e->syms[i]) { return e->slots[i]; }
+  
+  /* Keep the load factor under 3/4 */
+  if ((e->count + 1) * 4 > e->cap * 3) {
+    lenv_grow(e);
+    i = lenv_find(e, sym);
+  }
+  
+  if (e->slot_count == e->slot_cap) {
+    e->slot_cap *= 2;
+    e->vals = realloc(e->vals, sizeof(lval*) * e->slot_cap);
+    e->names = realloc(e->names, sizeof(char*) * e->slot_cap);
+  }
+  
+  /* Share the interned name */
+  e->count++;
+  e->syms[i] = sym;
+  e->slots[i] = e->slot_count;
+  e->vals[e->slot_count] = NULL;
+  e->names[e->slot_count] = sym;
+  return e->slot_count++;
+}
+
+/* Returns the innermost environment from e out binding sym, or NULL */
+lenv* lenv_scope(lenv* e, char* sym) {
+  for (; e; e = e->par) {
+    int s = lenv_slot(e, sym);
+    if (s >= 0 && e->vals[s]) { return e; }
+  }
+  return NULL;
+}
+
+/* Returns the value bound to sym without referencing it, or NULL */
+lval* lenv_peek(lenv* e, char* sym) {
+  for (; e; e = e->par) {
+    int s = lenv_slot(e, sym);
+    if (s >= 0 && e->vals[s]) { return e->vals[s]; }
+  }
+  return NULL;
+}
+
+lval* lenv_lookup(lenv* e, char* sym) {
+  
+  /* If the symbol is bound, return a reference to the value */
+  lval* x = lenv_peek(e, sym);
+  if (x) { return lval_ref(x); }
+  
+  /* If no symbol found return error */
+  return lval_err("Unbound Symbol '%s'", sym);
+}
+
+/* Returns the environment symbol k is found in from e. A symbol with */
+/* an address names it by how many frames out it is; any other is     */
+/* found by name, and NULL returned if it is unbound.                 */
+lenv* lenv_home(lenv* e, lval* k) {
+  if (k->depth < 0) { return lenv_scope(e, k->sym); }
+  for (int d = k->depth; d > 0; d--) { e = e->par; }
+  return e;
+}
+
+/* Returns the value bound to symbol k without referencing it, or NULL. */
+/* A symbol with an address is an array load. Its slot is only unknown  */
+/* for a global not yet defined when it was addressed, and is filled in */
+/* the first time it is found.                                          */
+lval* lenv_load(lenv* e, lval* k) {
+  
+  if (k->depth < 0) { return lenv_peek(e, k->sym); }
+  for (int d = k->depth; d > 0; d--) { e = e->par; }
+  
+  if (k->slot < 0) {
+    int s = lenv_slot(e, k->sym);
+    if (s < 0 || !e->vals[s]) { return NULL; }
+    k->slot = s;
+  }
+  return e->vals[k->slot];
+}
+
+lval* lenv_get(lenv* e, lval* k) {
+  
+  /* If the symbol is bound, return a reference to the value */
+  lval* x = lenv_load(e, k);
+  if (x) { return lval_ref(x); }
+  
+  return lval_err("Unbound Symbol '%s'", k->sym);
+}
+
+/* An inline cache for one site that loads a symbol. Until the version */
+/* of the environment it was filled from changes, the binding it found */
+/* can be neither replaced nor removed, so its slot is read unchecked. */
+/* Frames are made afresh for each call, so only top-level lookups are */
+/* worth caching.                                                      */
+typedef struct {
+  lenv* env;
+  long version;
+  int slot;
+} lic;
+
+lval* lic_get(lic* c, lenv* e, lval* k) {
+  if (c->env == e && c->version == e->version) {
+    return lval_ref(e->vals[c->slot]);
+  }
+  
+  /* On a miss look the symbol up and remember where it was found */
+  lval* x = lenv_get(e, k);
+  if (!e->par && lval_type(x) != LVAL_ERR) {
+    c->env = e;
+    c->version = e->version;
+    c->slot = lenv_slot(e, k->sym);
+  }
+  return x;
+}
+
+void lenv_put(lenv* e, lval* k, lval* v) {
+  
+  int s = lenv_resolve(e, k->sym);
+  
+  /* If variable already exists replace its value. Rebinding bumps */
+  /* the version so anything resolved against the old one rechecks. */
+  if (e->vals[s]) {
+    e->version = ++lenv_versions;
+    lval_del(e->vals[s]);
+  }
+  
+  /* Store a reference to the value */
+  e->vals[s] = lval_ref(v);
+  lgc_barrier_env(e, s, v);
+}
+
+void lenv_remove(lenv* e, lval* k) {
+  
+  /* The name keeps its slot, which is just emptied. Bumping the */
+  /* version sends anything resolved against it back to look.    */
+  int s = lenv_slot(e, k->sym);
+  if (s < 0 || !e->vals[s]) { return; }
+  
+  e->version = ++lenv_versions;
+  lval_del(e->vals[s]);
+  e->vals[s] = NULL;
+}
+
+/* Garbage Collection */
+
+/* Reference counting frees most values the moment they are dropped.   */
+/* The tracing collector backs it up: it marks everything reachable    */
+/* from the live environments and the evaluation root stack, then      */
+/* sweeps every other node in the heap regardless of its count.        */
+/*                                                                     */
+/* Collections only run at safe points in lval_eval, so any lval held  */
+/* in a C local across a call to lval_eval must be pushed on the root  */
+/* stack with lgc_push. A collection is due once the live node count   */
+/* passes a threshold, which is reset after each collection to the     */
+/* surviving count scaled by the growth percentage.                    */
+
+#define LGC_GROWTH 200
+#define LGC_MINIMUM 65536
+
+struct {
+  lenv** envs;
+  int env_count;
+  lval** roots;
+  int root_count;
+  int root_cap;
+  lval** stack;
+  int stack_cap;
+  long threshold;
+  long growth;
+  long minimum;
+  long collections;
+  long freed;
+} lgc = { NULL, 0, NULL, 0, 0, NULL, 0,
+          LGC_MINIMUM, LGC_GROWTH, LGC_MINIMUM, 0, 0 };
+
+void lgc_add_env(lenv* e) {
+  lgc.envs = realloc(lgc.envs, sizeof(lenv*) * (lgc.env_count + 1));
+  lgc.envs[lgc.env_count++] = e;
+}
+
+void lgc_remove_env(lenv* e) {
+  
+  /* Forget any slots of e remembered by the write barrier */
+  int n = 0;
+  for (int i = 0; i < lremembered.slot_count; i++) {
+    if (lremembered.slots[i].env != e) {
+      lremembered.slots[n++] = lremembered.slots[i];
+    }
+  }
+  lremembered.slot_count = n;
+  
+  for (int i = 0; i < lgc.env_count; i++) {
+    if (lgc.envs[i] == e) {
+      lgc.envs[i] = lgc.envs[--lgc.env_count];
+      return;
+    }
+  }
+}
+
+void lgc_push(lval* v) {
+  if (lgc.root_count == lgc.root_cap) {
+    lgc.root_cap = lgc.root_cap ? lgc.root_cap * 2 : 64;
+    lgc.roots = realloc(lgc.roots, sizeof(lval*) * lgc.root_cap);
+  }
+  lgc.roots[lgc.root_count++] = v;
+}
+
+void lgc_pop(void) {
+  lgc.root_count--;
+}
+
+/* Makes room for n entries on the mark stack */
+void lgc_reserve(int n) {
+  if (n <= lgc.stack_cap) { return; }
+  if (lgc.stack_cap == 0) { lgc.stack_cap = 256; }
+  while (n > lgc.stack_cap) { lgc.stack_cap *= 2; }
+  lgc.stack = realloc(lgc.stack, sizeof(lval*) * lgc.stack_cap);
+}
+
+/* Marks v and everything reachable from it using an explicit stack. */
+/* Frames are not nodes, so they are marked through the lambdas that */
+/* close over them; a frame in use by a call holds only values its   */
+/* caller has rooted.                                                */
+void lgc_mark(lval* v) {
+  
+  int n = 0;
+  lgc_reserve(1);
+  lgc.stack[n++] = v;
+  
+  while (n > 0) {
+    lval* x = lgc.stack[--n];
+    
+    /* Cells are briefly NULL while being evaluated */
+    if (x == NULL || lval_is_fix(x) || (x->flags & LGC_MARKED)) { continue; }
+    x->flags |= LGC_MARKED;
+    
+    if (x->type == LVAL_LAMBDA) {
+      lgc_reserve(n + 1);
+      lgc.stack[n++] = x->code;
+      for (lenv* e = x->env; e->par; e = e->par) {
+        lgc_reserve(n + e->slot_count);
+        for (int i = 0; i < e->slot_count; i++) {
+          lgc.stack[n++] = e->vals[i];
+        }
+      }
+      continue;
+    }
+    
+    if (x->type != LVAL_SEXPR && x->type != LVAL_QEXPR) { continue; }
+    lgc_reserve(n + x->count);
+    for (int i = 0; i < x->count; i++) {
+      lgc.stack[n++] = x->cell[i];
+    }
+  }
+}
+
+/* An unreachable node no longer holds its children, so any child */
+/* that survives loses the reference it was counted for. A frame  */
+/* held by an unreachable lambda is left as it is, since freeing  */
+/* it now would release values the sweep is about to free.        */
+void lgc_release(lval* v) {
+  if (v->flags & LGC_MARKED) { return; }
+  if (v->type == LVAL_LAMBDA) {
+    lval* x = v->code;
+    if (x->flags & LGC_MARKED) { x->refs--; }
+    return;
+  }
+  if (v->type != LVAL_SEXPR && v->type != LVAL_QEXPR) { return; }
+  for (int i = 0; i < v->count; i++) {
+    lval* x = v->cell[i];
+    if (x && !lval_is_fix(x) && (x->flags & LGC_MARKED)) { x->refs--; }
+  }
+}
+
+void lgc_sweep(lval* v) {
+  
+  if (v->flags & LGC_MARKED) {
+    v->flags &= ~LGC_MARKED;
+    return;
+  }
+  
+  switch (v->type) {
+    case LVAL_ERR: free(v->err); break;
+    case LVAL_BIG: free(v->digits); break;
+    case LVAL_SEXPR:
+    case LVAL_QEXPR: lcell_free(v->cell, v->count); break;
+  }
+  lval_free(v);
+  lgc.freed++;
+}
+
+void ltier_lines_mark(void);
+void ltier_lines_evacuate(int* n);
+
+/* Returns the number of nodes freed */
+long lgc_collect(void) {
+  
+  long freed = lgc.freed;
+  
+  for (int i = 0; i < lgc.env_count; i++) {
+    lenv* e = lgc.envs[i];
+    for (int j = lenv_next(e, 0); j != -1; j = lenv_next(e, j+1)) {
+      lgc_mark(e->vals[j]);
+    }
+  }
+  for (int i = 0; i < lgc.root_count; i++) {
+    lgc_mark(lgc.roots[i]);
+  }
+  
+  /* Queued cells keep their references until a slice drops them */
+  for (int i = 0; i < lfree.count; i++) {
+    lfree_entry* q = &lfree.queue[i];
+    for (int j = q->next; j < q->count; j++) {
+      if (q->cell[j]) { lgc_mark(q->cell[j]); }
+    }
+  }
+  
+  /* As are the forms of hot lines entered at the prompt */
+  ltier_lines_mark();
+  
+  lheap_walk(lgc_release);
+  lheap_walk(lgc_sweep);
+  
+  long live = lheap[LHEAP_NODE].live;
+  lgc.threshold = live * lgc.growth / 100;
+  if (lgc.threshold < lgc.minimum) { lgc.threshold = lgc.minimum; }
+  lgc.collections++;
+  
+  return lgc.freed - freed;
+}
+
+int lgc_due(void) {
+  return lheap[LHEAP_NODE].live > lgc.threshold;
+}
+
+int lgc_safepoint_due(void) {
+  return lfree.pending > LFREE_BACKLOG || lgc_due();
+}
+
+/* Everything the caller holds must be on the root stack */
+void lgc_safepoint(void) {
+  if (lfree.pending > LFREE_BACKLOG) { lfree_slice(); }
+  if (lgc_due()) { lgc_collect(); }
+}
+
+/* Copies a surviving nursery node into the node slabs, leaving a */
+/* forwarding address behind so every reference finds the copy.  */
+lval* lgc_evacuate(lval* x, int* n) {
+  
+  if (x == NULL || lval_is_fix(x) || !lval_in_nursery(x)) { return x; }
+  if (x->type == LHEAP_FORWARD) { return x->fwd; }
+  
+  lval* y = lheap_take(LHEAP_NODE);
+  *y = *x;
+  y->flags = 0;
+  x->type = LHEAP_FORWARD;
+  x->fwd = y;
+  lnursery.live--;
+  lnursery.promoted++;
+  
+  /* Queue promoted lists and lambdas so what they hold gets evacuated */
+  if (y->type == LVAL_SEXPR || y->type == LVAL_QEXPR || y->type == LVAL_LAMBDA) {
+    lgc_reserve(*n + 1);
+    lgc.stack[(*n)++] = y;
+  }
+  return y;
+}
+
+/* Evacuates what an old node holds. The frames a lambda closes over */
+/* are never written after they are made, so they are updated along  */
+/* with the first lambda that reaches them.                          */
+void lgc_evacuate_kids(lval* y, int* n) {
+  if (y->type == LVAL_LAMBDA) {
+    y->code = lgc_evacuate(y->code, n);
+    for (lenv* e = y->env; e->par; e = e->par) {
+      for (int j = 0; j < e->slot_count; j++) {
+        e->vals[j] = lgc_evacuate(e->vals[j], n);
+      }
+    }
+    return;
+  }
+  if (y->type != LVAL_SEXPR && y->type != LVAL_QEXPR) { return; }
+  for (int j = 0; j < y->count; j++) {
+    y->cell[j] = lgc_evacuate(y->cell[j], n);
+  }
+}
+
+/* Minor collection. Must run with nothing on the root stack, i.e. */
+/* between top level evaluations, since it moves nursery nodes.    */
+void lgc_minor(void) {
+  
+  if (lnursery.bump == lnursery.start) { return; }
+  
+  int n = 0;
+  
+  for (int i = 0; i < lremembered.slot_count; i++) {
+    lenv* e = lremembered.slots[i].env;
+    int j = lremembered.slots[i].slot;
+    if (e->vals[j]) { e->vals[j] = lgc_evacuate(e->vals[j], &n); }
+  }
+  
+  for (int i = 0; i < lremembered.node_count; i++) {
+    lval* p = lremembered.nodes[i];
+    /* The node may have been freed, or reused, since it was recorded */
+    if (p->type == LHEAP_FREE || !(p->flags & LGC_REMEMBERED)) { continue; }
+    p->flags &= ~LGC_REMEMBERED;
+    lgc_evacuate_kids(p, &n);
+  }
+  
+  for (int i = 0; i < lfree.count; i++) {
+    lfree_entry* q = &lfree.queue[i];
+    for (int j = q->next; j < q->count; j++) {
+      q->cell[j] = lgc_evacuate(q->cell[j], &n);
+    }
+  }
+  
+  ltier_lines_evacuate(&n);
+  
+  while (n > 0) {
+    lgc_evacuate_kids(lgc.stack[--n], &n);
+  }
+  
+  /* Anything left is unreachable but was never released. Free what */
+  /* it owns; counts it held on old nodes are left for lgc_collect.  */
+  if (lnursery.live > 0) {
+    for (char* p = lnursery.start; p < lnursery.bump; p += sizeof(lval)) {
+      lval* v = (lval*)p;
+      if (v->type == LHEAP_FREE || v->type == LHEAP_FORWARD) { continue; }
+      switch (v->type) {
+        case LVAL_ERR: free(v->err); break;
+        case LVAL_BIG: free(v->digits); break;
+        case LVAL_SEXPR:
+        case LVAL_QEXPR: lcell_free(v->cell, v->count); break;
+      }
+      lheap[LHEAP_NODE].frees++;
+      lheap[LHEAP_NODE].live--;
+    }
+    lnursery.live = 0;
+  }
+  
+  lnursery.bump = lnursery.start;
+  lnursery.collections++;
+  lremembered.node_count = 0;
+  lremembered.slot_count = 0;
+}
+
+void lheap_print_stats(void) {
+  printf("%-10s %6s %10s %10s %10s %6s\n",
+    "class", "size", "allocs", "frees", "live", "slabs");
+  for (int c = 0; c <= LHEAP_LARGE; c++) {
+    lclass* k = &lheap[c];
+    if (c == LHEAP_NODE) {
+      printf("%-10s %6zu", "node", lheap_size(c));
+    } else if (c == LHEAP_LARGE) {
+      printf("%-10s %6s", "cells/big", "-");
+    } else {
+      printf("cells/%-4i %6zu", 1 << c, lheap_size(c));
+    }
+    printf(" %10li %10li %10li %6li\n",
+      k->allocs, k->frees, k->live, k->slabs);
+  }
+  printf("nursery: %li allocs, %li promoted, %li minor collections\n",
+    lnursery.allocs, lnursery.promoted, lnursery.collections);
+  printf("deferred free: %li pending, %li released in %li slices, "
+    "max pause %li us, mean pause %li us, slice budget %li us\n",
+    lfree.pending, lfree.released, lfree.slices, lfree.max_ns / 1000,
+    lfree.slices ? lfree.total_ns / lfree.slices / 1000 : 0, lfree.budget);
+}
+
+/* Builtins */
+
+/* A builtin is called on an array of arguments it borrows from the   */
+/* caller, which holds them as roots and releases them afterwards, so */
+/* no argument list is built and nothing is moved to reach the next   */
+/* argument. Anything a builtin keeps or returns it must reference.   */
+/* Builtins of one or two arguments may give entries taking them      */
+/* directly, which calls of that arity use in place of the general    */
+/* one; a builtin with no general entry takes only those arities.     */
+
+struct lprim {
+  char* name;
+  lbuiltin any;
+  lbuiltin1 one;
+  lbuiltin2 two;
+};
+
+#define LASSERT(cond, fmt, ...) \
+  if (!(cond)) { return lval_err(fmt, ##__VA_ARGS__); }
+
+#define LASSERT_TYPE(func, x, index, expect) \
+  LASSERT(lval_type(x) == expect, \
+    "Function '%s' passed incorrect type for argument %i. Got %s, Expected %s.", \
+    func, index, ltype_name(lval_type(x)), ltype_name(expect))
+
+#define LASSERT_NUMBER(func, x, index) \
+  LASSERT(lval_type(x) == LVAL_NUM || lval_type(x) == LVAL_BIG, \
+    "Function '%s' passed incorrect type for argument %i. Got %s, Expected %s.", \
+    func, index, ltype_name(lval_type(x)), ltype_name(LVAL_NUM))
+
+#define LASSERT_NUM(func, argc, num) \
+  LASSERT(argc == num, \
+    "Function '%s' passed incorrect number of arguments. Got %i, Expected %i.", \
+    func, argc, num)
+
+#define LASSERT_NOT_EMPTY(func, x, index) \
+  LASSERT(x->count != 0, \
+    "Function '%s' passed {} for argument %i.", func, index);
+
+
+lval* lval_eval(lenv* e, lval* v);
+lval* lval_walk(lenv* e, lval* v, int tail);
+
+typedef struct lcode lcode;
+lcode* lcode_cached(lval* v);
+lval* lvm_run(lenv* e, lcode* c, int tail);
+
+typedef struct lclo lclo;
+lclo* lclo_cached(lenv* e, lval* v);
+lval* lclo_run(lenv* e, lclo* c, int tail);
+
+/* Evaluation backends, switched at runtime with the backend builtin. */
+/* Tiered, the default, walks the tree until a form passed to eval or */
+/* a line entered at the prompt has run often enough to be worth      */
+/* compiling to a closure; closures in turn move hot arithmetic to    */
+/* native code where that is available.                               */
+enum { LBACKEND_TREE, LBACKEND_VM, LBACKEND_CLOSURE, LBACKEND_TIERED };
+
+int lbackend = LBACKEND_TIERED;
+
+#define LTIER_HOT 8
+
+struct {
+  long threshold;
+  long cold;
+  long warm;
+  long native;
+  long promotions;
+  long compiles;
+} ltier = { LTIER_HOT, 0, 0, 0, 0, 0 };
+
+lclo* ltier_closure(lenv* e, lval* v);
+void ltier_print_stats(void);
+
+lval* builtin_list(lenv* e, int argc, lval** argv) {
+  return lval_list(LVAL_QEXPR, argv, argc);
+}
+
+lval* builtin_head(lenv* e, lval* q) {
+  LASSERT_TYPE("head", q, 0, LVAL_QEXPR);
+  LASSERT_NOT_EMPTY("head", q, 0);
+  return lval_list(LVAL_QEXPR, q->cell, 1);
+}
+
+lval* builtin_tail(lenv* e, lval* q) {
+  LASSERT_TYPE("tail", q, 0, LVAL_QEXPR);
+  LASSERT_NOT_EMPTY("tail", q, 0);
+  return lval_list(LVAL_QEXPR, q->cell + 1, q->count - 1);
+}
+
+/* Lambda bodies and forms passed to eval that are not in tail     */
+/* position run on the C stack. How far they nest is measured from */
+/* the outermost one, and going past half the stack limit is an    */
+/* error, so runaway recursion fails rather than crashing.         */
+struct {
+  int depth;
+  char* base;
+  long budget;
+} lcall = { 0, NULL, 0 };
+
+int lcall_too_deep(void) {
+  
+  char here;
+  if (lcall.depth == 0) { lcall.base = &here; }
+  
+  if (!lcall.budget) {
+    struct rlimit r;
+    lcall.budget = 8L << 20;
+    if (getrlimit(RLIMIT_STACK, &r) == 0 && r.rlim_cur != RLIM_INFINITY
+        && r.rlim_cur < (rlim_t)lcall.budget) {
+      lcall.budget = r.rlim_cur;
+    }
+    lcall.budget /= 2;
+  }
+  
+  /* The stack grows down */
+  return lcall.base - &here > lcall.budget;
+}
+
+lval* lval_run_quoted(lenv* e, lval* q, int again, int tail) {
+  
+  if (again && lbackend == LBACKEND_VM) {
+    lcode* c = lcode_cached(q);
+    if (c) { return lvm_run(e, c, tail); }
+  }
+  if (again && (lbackend == LBACKEND_CLOSURE || lbackend == LBACKEND_TIERED)) {
+    lclo* c = lbackend == LBACKEND_TIERED
+      ? ltier_closure(e, q)
+      : lclo_cached(e, q);
+    if (c) { return lclo_run(e, c, tail); }
+  }
+  if (!again && lbackend == LBACKEND_TIERED) { ltier.cold++; }
+  
+  /* The argument is borrowed, so the walk consumes a copy */
+  lval* x = lval_list(LVAL_SEXPR, q->cell, q->count);
+  return lval_walk(e, x, tail);
+}
+
+/* Evaluates the borrowed Q-Expression q as an S-Expression. One that */
+/* will be evaluated again is run from cached code rather than by     */
+/* consuming a copy of the tree. In tail position the outermost call  */
+/* may be left pending, see ltail.                                    */
+lval* lval_eval_quoted(lenv* e, lval* q, int again, int tail) {
+  
+  if (lcall_too_deep()) { return lval_err("Calls Nested Too Deep."); }
+  
+  lcall.depth++;
+  lval* x = lval_run_quoted(e, q, again, tail);
+  lcall.depth--;
+  return x;
+}
+
+lval* builtin_eval(lenv* e, lval* q) {
+  LASSERT_TYPE("eval", q, 0, LVAL_QEXPR);
+  
+  /* Nothing else holding q means it dies once this call returns */
+  return lval_eval_quoted(e, q, q->refs >= 2, 0);
+}
+
+lval* lval_address(lenv* e, lval* formals, lval* body);
+
+lval* builtin_lambda(lenv* e, lval* formals, lval* body) {
+  LASSERT_TYPE("\\", formals, 0, LVAL_QEXPR);
+  LASSERT_TYPE("\\", body, 1, LVAL_QEXPR);
+  
+  /* Check Q-Expression contains only Symbols */
+  for (int i = 0; i < formals->count; i++) {
+    LASSERT((lval_type(formals->cell[i]) == LVAL_SYM),
+      "Function '\\' cannot define non-symbol. "
+      "Got %s, Expected %s.",
+      ltype_name(lval_type(formals->cell[i])), ltype_name(LVAL_SYM));
+  }
+  
+  /* An S-Expression of one value is that value, so (f) could never */
+  /* call a lambda taking no arguments                              */
+  LASSERT(formals->count > 0,
+    "Function '\\' cannot define a lambda of no arguments, "
+    "which could never be called.");
+  
+  /* The code shares the formals, which stay unchanged, and has its */
+  /* own copy of the body to address                                */
+  lval* code[] = { formals, lval_address(e, formals, body) };
+  lval* x = lval_lambda(lval_list(LVAL_QEXPR, code, 2), e);
+  lval_del(code[1]);
+  return x;
+}
+
+lval* builtin_join(lenv* e, int argc, lval** argv) {
+  
+  for (int i = 0; i < argc; i++) {
+    LASSERT_TYPE("join", argv[i], i, LVAL_QEXPR);
+  }
+  
+  /* Size the result once and share every element */
+  int n = 0;
+  for (int i = 0; i < argc; i++) { n += argv[i]->count; }
+  
+  lval* x = lval_qexpr();
+  x->cell = lcell_alloc(n);
+  for (int i = 0; i < argc; i++) {
+    for (int j = 0; j < argv[i]->count; j++) {
+      x->cell[x->count++] = lval_ref(argv[i]->cell[j]);
+      lgc_barrier(x, argv[i]->cell[j]);
+    }
+  }
+  return x;
+}
+
+/* Raises x to the power y >= 0 by squaring, returning 0 on overflow */
+int lpow(long x, long y, long* r) {
+  long acc = 1;
+  while (y > 0) {
+    if ((y & 1) && __builtin_mul_overflow(acc, x, &acc)) { return 0; }
+    y >>= 1;
+    if (y > 0 && __builtin_mul_overflow(x, x, &x)) { return 0; }
+  }
+  *r = acc;
+  return 1;
+}
+
+/* One step of **, which adds the power to the running value */
+int lpow_step(long x, long y, long* r) {
+  long p;
+  if (y < 0 || !lpow(x, y, &p)) { return 0; }
+  return !__builtin_add_overflow(x, p, r);
+}
+
+/* Arithmetic operators, resolved once from the builtin rather than */
+/* by comparing operator names for every argument                  */
+enum { LARITH_ADD, LARITH_SUB, LARITH_MUL, LARITH_DIV, LARITH_MOD,
+       LARITH_AND, LARITH_OR, LARITH_POW, LARITH_MIN, LARITH_MAX };
+
+char* larith_names[] = { "+", "-", "*", "/", "%", "&", "|", "**", "min", "max" };
+
+/* Each operator has its own kernel, generated from its step below, */
+/* that folds the numbers xs[1..n) into *x in one loop with no      */
+/* dispatch inside it. Steps that could overflow or divide by zero  */
+/* are checked: the kernel stops before such a step, or before a    */
+/* bignum, leaving *x as it was, and returns its index. A kernel    */
+/* that finishes returns n.                                         */
+
+typedef int (*lkernel)(long*, lval**, int);
+
+#define LARITH_STOP { *x = a; return i; }
+
+#define LARITH_KERNEL(name, ...) \
+  int larith_##name(long* x, lval** xs, int n) { \
+    long a = *x; \
+    for (int i = 1; i < n; i++) { \
+      if (lval_type(xs[i]) != LVAL_NUM) LARITH_STOP \
+      long b = lval_as_num(xs[i]); \
+      __VA_ARGS__ \
+    } \
+    *x = a; \
+    return n; \
+  }
+
+LARITH_KERNEL(add, long r; if (__builtin_add_overflow(a, b, &r)) LARITH_STOP; a = r;)
+LARITH_KERNEL(sub, long r; if (__builtin_sub_overflow(a, b, &r)) LARITH_STOP; a = r;)
+LARITH_KERNEL(mul, long r; if (__builtin_mul_overflow(a, b, &r)) LARITH_STOP; a = r;)
+LARITH_KERNEL(div, if (b == 0 || (b == -1 && a == LONG_MIN)) LARITH_STOP; a /= b;)
+LARITH_KERNEL(mod, if (b == 0) LARITH_STOP; a = b == -1 ? 0 : a % b;)
+LARITH_KERNEL(and, a &= b;)
+LARITH_KERNEL(or, a |= b;)
+LARITH_KERNEL(pow, long r; if (!lpow_step(a, b, &r)) LARITH_STOP; a = r;)
+LARITH_KERNEL(min, if (b < a) { a = b; })
+LARITH_KERNEL(max, if (b > a) { a = b; })
+
+lkernel larith_kernels[] = {
+  larith_add, larith_sub, larith_mul, larith_div, larith_mod,
+  larith_and, larith_or, larith_pow, larith_min, larith_max };
+
+/* Vector Reductions */
+
+/* +, &, |, min and max over many arguments are reduced several at a  */
+/* time straight from the argument array. Small numbers are tagged     */
+/* immediates, so a vector of cells decodes to a vector of numbers     */
+/* with a shift, and one AND across all of them tells whether any was  */
+/* boxed, in which case the scalar kernel runs instead. Sums are only  */
+/* kept when a bound on the magnitudes shows no prefix sum taken in    */
+/* order could have overflowed, so the result is always the one the    */
+/* scalar kernel would give. * has no 64-bit vector multiply to use.   */
+/* The widest kernel the CPU supports is picked on first use.          */
+
+#ifdef VHISP_SIMD
+
+#define LSIMD_MIN 16
+
+typedef int (*lsimdfn)(int, lval**, int, long*);
+
+/* Combines two partial results of op */
+long lsimd_combine(int op, long a, long b) {
+  switch (op) {
+    case LARITH_ADD: return (long)((unsigned long)a + (unsigned long)b);
+    case LARITH_AND: return a & b;
+    case LARITH_OR:  return a | b;
+    case LARITH_MIN: return b < a ? b : a;
+    case LARITH_MAX: return b > a ? b : a;
+  }
+  return a;
+}
+
+long lsimd_identity(int op) {
+  switch (op) {
+    case LARITH_AND: return -1;
+    case LARITH_MIN: return LONG_MAX;
+    case LARITH_MAX: return LONG_MIN;
+  }
+  return 0;
+}
+
+/* Finishes a reduction from its lanes and the cells past them, or  */
+/* returns 0 if any cell was boxed or a sum might have overflowed.  */
+/* mag is the OR of every number with its sign bits flipped off.    */
+int lsimd_finish(int op, long* lanes, int width, long tags, long mag,
+                 lval** xs, int i, int n, long* r) {
+  
+  long x = lsimd_identity(op);
+  for (int k = 0; k < width; k++) { x = lsimd_combine(op, x, lanes[k]); }
+  
+  for (; i < n; i++) {
+    long v = (long)xs[i];
+    tags &= v;
+    v >>= 1;
+    mag |= v ^ (v >> 63);
+    x = lsimd_combine(op, x, v);
+  }
+  if (!(tags & 1)) { return 0; }
+  
+  /* Every number is below 2^bits in magnitude, so every prefix sum */
+  /* is below n * 2^bits                                            */
+  if (op == LARITH_ADD) {
+    int bits = mag ? 64 - __builtin_clzl(mag) : 0;
+    int count = 64 - __builtin_clzl((unsigned long)n);
+    if (bits + count > 62) { return 0; }
+  }
+  
+  *r = x;
+  return 1;
+}
+
+/* Reduces n cells of xs with op four at a time, with x holding each  */
+/* decoded vector of numbers for the body and acc the partial results */
+#define LSIMD_AVX2_LOOP(body) \
+  for (; i + 4 <= n; i += 4) { \
+    __m256i v = _mm256_loadu_si256((__m256i*)(xs + i)); \
+    tags = _mm256_and_si256(tags, v); \
+    __m256i x = _mm256_or_si256(_mm256_srli_epi64(v, 1), _mm256_and_si256(v, sign)); \
+    body \
+  }
+
+__attribute__((target("avx2")))
+int lsimd_fold_avx2(int op, lval** xs, int n, long* r) {
+  
+  const __m256i sign = _mm256_set1_epi64x(LONG_MIN);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i tags = _mm256_set1_epi64x(-1);
+  __m256i mag = zero;
+  __m256i acc = _mm256_set1_epi64x(lsimd_identity(op));
+  int i = 0;
+  
+  switch (op) {
+    case LARITH_ADD:
+      LSIMD_AVX2_LOOP(
+        acc = _mm256_add_epi64(acc, x);
+        mag = _mm256_or_si256(mag, _mm256_xor_si256(x, _mm256_cmpgt_epi64(zero, x)));)
+    break;
+    case LARITH_AND: LSIMD_AVX2_LOOP(acc = _mm256_and_si256(acc, x);) break;
+    case LARITH_OR:  LSIMD_AVX2_LOOP(acc = _mm256_or_si256(acc, x);) break;
+    case LARITH_MIN:
+      LSIMD_AVX2_LOOP(acc = _mm256_blendv_epi8(acc, x, _mm256_cmpgt_epi64(acc, x));)
+    break;
+    case LARITH_MAX:
+      LSIMD_AVX2_LOOP(acc = _mm256_blendv_epi8(acc, x, _mm256_cmpgt_epi64(x, acc));)
+    break;
+    default: return 0;
+  }
+  
+  long lanes[4], t[4], m[4];
+  _mm256_storeu_si256((__m256i*)lanes, acc);
+  _mm256_storeu_si256((__m256i*)t, tags);
+  _mm256_storeu_si256((__m256i*)m, mag);
+  return lsimd_finish(op, lanes, 4, t[0] & t[1] & t[2] & t[3],
+    m[0] | m[1] | m[2] | m[3], xs, i, n, r);
+}
+
+/* The same two at a time with SSE2, which every x86-64 CPU has but */
+/* which has no 64-bit compare, so it leaves min and max scalar     */
+#define LSIMD_SSE2_LOOP(body) \
+  for (; i + 2 <= n; i += 2) { \
+    __m128i v = _mm_loadu_si128((__m128i*)(xs + i)); \
+    tags = _mm_and_si128(tags, v); \
+    __m128i x = _mm_or_si128(_mm_srli_epi64(v, 1), _mm_and_si128(v, sign)); \
+    body \
+  }
+
+int lsimd_fold_sse2(int op, lval** xs, int n, long* r) {
+  
+  const __m128i sign = _mm_set1_epi64x(LONG_MIN);
+  __m128i tags = _mm_set1_epi64x(-1);
+  __m128i mag = _mm_setzero_si128();
+  __m128i acc = _mm_set1_epi64x(lsimd_identity(op));
+  int i = 0;
+  
+  switch (op) {
+    case LARITH_ADD:
+      LSIMD_SSE2_LOOP(
+        acc = _mm_add_epi64(acc, x);
+        __m128i s = _mm_shuffle_epi32(_mm_srai_epi32(x, 31), 0xf5);
+        mag = _mm_or_si128(mag, _mm_xor_si128(x, s));)
+    break;
+    case LARITH_AND: LSIMD_SSE2_LOOP(acc = _mm_and_si128(acc, x);) break;
+    case LARITH_OR:  LSIMD_SSE2_LOOP(acc = _mm_or_si128(acc, x);) break;
+    default: return 0;
+  }
+  
+  long lanes[2], t[2], m[2];
+  _mm_storeu_si128((__m128i*)lanes, acc);
+  _mm_storeu_si128((__m128i*)t, tags);
+  _mm_storeu_si128((__m128i*)m, mag);
+  return lsimd_finish(op, lanes, 2, t[0] & t[1], m[0] | m[1], xs, i, n, r);
+}
+
+lsimdfn lsimd_fold = NULL;
+
+/* Reduces n numbers with op into *r, or returns 0 if the scalar */
+/* kernel has to do it                                           */
+int lsimd_reduce(int op, lval** xs, int n, long* r) {
+  if (!lsimd_fold) {
+    __builtin_cpu_init();
+    lsimd_fold = __builtin_cpu_supports("avx2") ? lsimd_fold_avx2 : lsimd_fold_sse2;
+  }
+  return lsimd_fold(op, xs, n, r);
+}
+
+#endif
+
+/* Folds xs[i..n) into x with op as bignums, taking x's digits */
+lval* lbig_fold(int op, lbig x, lval** xs, int i, int n) {
+  
+  for (; i < n; i++) {
+    uint32_t buf[2];
+    lbig y = lbig_view(xs[i], buf);
+    lbig r = { NULL, 0, 0 };
+    lval* err = NULL;
+    
+    switch (op) {
+      case LARITH_ADD: r = lbig_add(x, y, 0); break;
+      case LARITH_SUB: r = lbig_add(x, y, 1); break;
+      case LARITH_MUL: r = lbig_mul(x, y); break;
+      case LARITH_DIV:
+      case LARITH_MOD: {
+        if (y.n == 0) {
+          err = lval_err("Division By Zero.");
+          break;
+        }
+        lbig q, m;
+        lbig_divmod(x, y, &q, &m);
+        if (op == LARITH_DIV) { r = q; free(m.d); } else { r = m; free(q.d); }
+      }
+      break;
+      case LARITH_AND: r = lbig_logic(1, x, y); break;
+      case LARITH_OR:  r = lbig_logic(0, x, y); break;
+      case LARITH_POW: {
+        if (y.neg) {
+          err = lval_err("Negative Exponent.");
+          break;
+        }
+        
+        /* Only 0, 1 and -1 can be raised to a bignum power, and for */
+        /* them just its parity matters                              */
+        long bits = lbig_bits(x);
+        int huge = lval_type(xs[i]) == LVAL_BIG;
+        long e = huge ? 2 + (y.d[0] & 1) : lval_as_num(xs[i]);
+        if (bits > 1 && (huge || e > LBIG_MAX_BITS / (bits - 1))) {
+          err = lval_err("Number Too Large.");
+          break;
+        }
+        lbig p = lbig_pow(x, e);
+        r = lbig_add(x, p, 0);
+        free(p.d);
+      }
+      break;
+      case LARITH_MIN: r = lbig_copy(lbig_cmp(y, x) < 0 ? y : x); break;
+      case LARITH_MAX: r = lbig_copy(lbig_cmp(y, x) > 0 ? y : x); break;
+    }
+    
+    free(x.d);
+    if (err) { return err; }
+    x = r;
+  }
+  
+  return lval_big(x);
+}
+
+/* Folds n numbers with op. Does not consume them. */
+lval* larith_fold(int op, lval** xs, int n) {
+  
+  if (lval_type(xs[0]) == LVAL_BIG) {
+    uint32_t buf[2];
+    lbig x = lbig_copy(lbig_view(xs[0], buf));
+    if (op == LARITH_SUB && n == 1) { x.neg = !x.neg; }
+    return lbig_fold(op, x, xs, 1, n);
+  }
+  
+  long x = lval_as_num(xs[0]);
+  
+  if (op == LARITH_SUB && n == 1) {
+    if (x == LONG_MIN) {
+      lbig y = lbig_from_long(x);
+      y.neg = 0;
+      return lval_big(y);
+    }
+    x = -x;
+  }
+  
+  #ifdef VHISP_SIMD
+  if (n >= LSIMD_MIN && lsimd_reduce(op, xs, n, &x)) { return lval_num(x); }
+  #endif
+  
+  int i = larith_kernels[op](&x, xs, n);
+  if (i == n) { return lval_num(x); }
+  
+  /* The kernel stopped on a step a long can't take. Anything other */
+  /* than an error there is an overflow, and carries on as bignums. */
+  if (lval_type(xs[i]) == LVAL_NUM) {
+    long y = lval_as_num(xs[i]);
+    if ((op == LARITH_DIV || op == LARITH_MOD) && y == 0) {
+      return lval_err("Division By Zero.");
+    }
+    if (op == LARITH_POW && y < 0) {
+      return lval_err("Negative Exponent.");
+    }
+  }
+  return lbig_fold(op, lbig_from_long(x), xs, i, n);
+}
+
+/* Checks folding xs with op gives a number rather than an error, */
+/* so that it is safe to do ahead of time                         */
+int larith_safe(int op, lval** xs, int n) {
+  long x = lval_as_num(xs[0]);
+  if (op == LARITH_SUB && n == 1) { return x != LONG_MIN; }
+  return larith_kernels[op](&x, xs, n) == n;
+}
+
+lval* builtin_op(lenv* e, int argc, lval** argv, int op) {
+  
+  for (int i = 0; i < argc; i++) {
+    LASSERT_NUMBER(larith_names[op], argv[i], i);
+  }
+  
+  /* Accumulate into a plain long. Numbers are immediates, so nothing */
+  /* is allocated or freed while folding the arguments.               */
+  return larith_fold(op, argv, argc);
+}
+
+lval* builtin_op1(lenv* e, lval* x, int op) {
+  LASSERT_NUMBER(larith_names[op], x, 0);
+  return larith_fold(op, &x, 1);
+}
+
+lval* builtin_op2(lenv* e, lval* x, lval* y, int op) {
+  LASSERT_NUMBER(larith_names[op], x, 0);
+  LASSERT_NUMBER(larith_names[op], y, 1);
+  lval* xs[] = { x, y };
+  return larith_fold(op, xs, 2);
+}
+
+/* Defines the entries of an arithmetic builtin and the lprim for them */
+#define LARITH_BUILTIN(name, op) \
+  lval* builtin_##name(lenv* e, int argc, lval** argv) { \
+    return builtin_op(e, argc, argv, op); \
+  } \
+  lval* builtin_##name##1(lenv* e, lval* x) { \
+    return builtin_op1(e, x, op); \
+  } \
+  lval* builtin_##name##2(lenv* e, lval* x, lval* y) { \
+    return builtin_op2(e, x, y, op); \
+  } \
+  lprim lprim_##name = { #name, builtin_##name, builtin_##name##1, builtin_##name##2 };
+
+LARITH_BUILTIN(add, LARITH_ADD)
+LARITH_BUILTIN(sub, LARITH_SUB)
+LARITH_BUILTIN(mul, LARITH_MUL)
+LARITH_BUILTIN(div, LARITH_DIV)
+LARITH_BUILTIN(mod, LARITH_MOD)
+LARITH_BUILTIN(and, LARITH_AND)
+LARITH_BUILTIN(or, LARITH_OR)
+LARITH_BUILTIN(pow, LARITH_POW)
+LARITH_BUILTIN(min, LARITH_MIN)
+LARITH_BUILTIN(max, LARITH_MAX)
+
+/* Returns the operator a builtin folds with, or -1 if it is not one */
+int larith_op(lprim* f) {
+  static lprim* prims[] = {
+    &lprim_add, &lprim_sub, &lprim_mul, &lprim_div, &lprim_mod,
+    &lprim_and, &lprim_or, &lprim_pow, &lprim_min, &lprim_max };
+  for (int i = 0; i < LARITH_MAX + 1; i++) {
+    if (prims[i] == f) { return i; }
+  }
+  return -1;
+}
+
+lval* builtin_def(lenv* e, int argc, lval** argv) {
+
+  LASSERT_TYPE("def", argv[0], 0, LVAL_QEXPR);
+  
+  /* Definitions are global, whichever frame they are made in */
+  while (e->par) { e = e->par; }
+  
+  /* First argument is symbol list */
+  lval* syms = argv[0];
+  
+  /* Ensure all elements of first list are symbols */
+  for (int i = 0; i < syms->count; i++) {
+    LASSERT((lval_type(syms->cell[i]) == LVAL_SYM),
+      "Function 'def' cannot define non-symbol. "
+      "Got %s, Expected %s.",
+      ltype_name(lval_type(syms->cell[i])), ltype_name(LVAL_SYM));
+  }
+  
+  /* Check correct number of symbols and values */
+  LASSERT((syms->count == argc-1),
+    "Function 'def' passed too many arguments for symbols. "
+    "Got %i, Expected %i.",
+    syms->count, argc-1);
+  
+  /* Bind the values to symbols, sharing rather than copying them */
+  for (int i = 0; i < syms->count; i++) {
+    lenv_put(e, syms->cell[i], argv[i+1]);
+  }
+  
+  return lval_sexpr();
+}
+
+lval* builtin_gc(lenv* e, lval* t) {
+  LASSERT_TYPE("gc", t, 0, LVAL_QEXPR);
+  
+  /* Optional {growth minimum} tunes the collection threshold and */
+  /* {growth minimum slice} also sets the free slice budget in us  */
+  LASSERT(t->count == 0 || t->count == 2 || t->count == 3,
+    "Function 'gc' expects {}, {growth minimum} or "
+    "{growth minimum slice}. Got %i items.",
+    t->count);
+  for (int i = 0; i < t->count; i++) {
+    LASSERT(lval_type(t->cell[i]) == LVAL_NUM,
+      "Function 'gc' passed non-number tuning values.");
+  }
+  if (t->count >= 2) {
+    lgc.growth = lval_as_num(t->cell[0]);
+    lgc.minimum = lval_as_num(t->cell[1]);
+  }
+  if (t->count == 3) {
+    lfree.budget = lval_as_num(t->cell[2]);
+  }
+  
+  long freed = lgc_collect();
+  lval* x = lval_qexpr();
+  x = lval_add(x, lval_num(freed));
+  x = lval_add(x, lval_num(lheap[LHEAP_NODE].live));
+  return x;
+}
+
+lval* builtin_memstats(lenv* e, lval* a) {
+  LASSERT_TYPE("memstats", a, 0, LVAL_QEXPR);
+  
+  /* {free} returns the deferred free figures rather than printing */
+  /* them, as {pending released slices max-pause mean-pause slice} */
+  /* with times in us, so a script can check them                  */
+  int figures = a->count == 1 && lval_type(a->cell[0]) == LVAL_SYM
+    && a->cell[0]->sym == lsym_intern("free");
+  LASSERT(a->count == 0 || figures,
+    "Function 'memstats' expects {} or {free}.");
+  
+  if (!figures) {
+    lheap_print_stats();
+    return lval_sexpr();
+  }
+  
+  lval* x = lval_qexpr();
+  x = lval_add(x, lval_num(lfree.pending));
+  x = lval_add(x, lval_num(lfree.released));
+  x = lval_add(x, lval_num(lfree.slices));
+  x = lval_add(x, lval_num(lfree.max_ns / 1000));
+  x = lval_add(x, lval_num(lfree.slices ? lfree.total_ns / lfree.slices / 1000 : 0));
+  x = lval_add(x, lval_num(lfree.budget));
+  return x;
+}
+
+lval* builtin_tiers(lenv* e, lval* t) {
+  LASSERT_TYPE("tiers", t, 0, LVAL_QEXPR);
+  
+  /* Optional {threshold} sets how many runs promote a form */
+  LASSERT(t->count == 0 || t->count == 1,
+    "Function 'tiers' expects {} or {threshold}. Got %i items.",
+    t->count);
+  if (t->count == 1) {
+    LASSERT(lval_type(t->cell[0]) == LVAL_NUM && lval_as_num(t->cell[0]) > 0,
+      "Function 'tiers' passed a non-positive threshold.");
+    ltier.threshold = lval_as_num(t->cell[0]);
+  }
+  
+  ltier_print_stats();
+  return lval_sexpr();
+}
+
+lval* builtin_backend(lenv* e, lval* t) {
+  LASSERT_TYPE("backend", t, 0, LVAL_QEXPR);
+  
+  /* Selects how top-level input and eval are run, for comparing them */
+  char* names[] = { "tree", "vm", "closure", "tiered" };
+  int mode = -1;
+  for (int i = 0; i < 4; i++) {
+    if (t->count == 1 && lval_type(t->cell[0]) == LVAL_SYM
+        && t->cell[0]->sym == lsym_intern(names[i])) {
+      mode = i;
+    }
+  }
+  LASSERT(mode >= 0,
+    "Function 'backend' expects {tree}, {vm}, {closure} or {tiered}.");
+  
+  lbackend = mode;
+  return lval_sexpr();
+}
+
+lprim lprim_def = { "def", builtin_def, NULL, NULL };
+lprim lprim_list = { "list", builtin_list, NULL, NULL };
+lprim lprim_head = { "head", NULL, builtin_head, NULL };
+lprim lprim_tail = { "tail", NULL, builtin_tail, NULL };
+lprim lprim_eval = { "eval", NULL, builtin_eval, NULL };
+lprim lprim_lambda = { "\\", NULL, NULL, builtin_lambda };
+lprim lprim_join = { "join", builtin_join, NULL, NULL };
+lprim lprim_gc = { "gc", NULL, builtin_gc, NULL };
+lprim lprim_memstats = { "memstats", NULL, builtin_memstats, NULL };
+lprim lprim_backend = { "backend", NULL, builtin_backend, NULL };
+lprim lprim_tiers = { "tiers", NULL, builtin_tiers, NULL };
+
+void lenv_add_builtin(lenv* e, char* name, lprim* func) {
+  lval* k = lval_sym(name);
+  lval* v = lval_fun(func);
+  lenv_put(e, k, v);
+  lval_del(k); lval_del(v);
+}
+
+void lenv_add_builtins(lenv* e) {
+  /* Variable Functions */
+  lenv_add_builtin(e, "\\", &lprim_lambda);
+  lenv_add_builtin(e, "def", &lprim_def);
+  
+  /* List Functions */
+  lenv_add_builtin(e, "list", &lprim_list);
+  lenv_add_builtin(e, "head", &lprim_head);
+  lenv_add_builtin(e, "tail", &lprim_tail);
+  lenv_add_builtin(e, "eval", &lprim_eval);
+  lenv_add_builtin(e, "join", &lprim_join);
+  
+  /* Mathematical Functions */
+  lenv_add_builtin(e, "+", &lprim_add);
+  lenv_add_builtin(e, "-", &lprim_sub);
+  lenv_add_builtin(e, "*", &lprim_mul);
+  lenv_add_builtin(e, "/", &lprim_div);
+  lenv_add_builtin(e, "%", &lprim_mod);
+  lenv_add_builtin(e, "&", &lprim_and);
+  lenv_add_builtin(e, "|", &lprim_or);
+  lenv_add_builtin(e, "**", &lprim_pow);
+  lenv_add_builtin(e, ">", &lprim_max);
+  lenv_add_builtin(e, "<", &lprim_min);
+  
+  lenv_add_builtin(e, "add", &lprim_add);
+  lenv_add_builtin(e, "sub", &lprim_sub);
+  lenv_add_builtin(e, "mul", &lprim_mul);
+  lenv_add_builtin(e, "div", &lprim_div);
+  lenv_add_builtin(e, "mod", &lprim_mod);
+  lenv_add_builtin(e, "and", &lprim_and);
+  lenv_add_builtin(e, "or", &lprim_or);
+  lenv_add_builtin(e, "pow", &lprim_pow);
+  lenv_add_builtin(e, "max", &lprim_max);
+  lenv_add_builtin(e, "min", &lprim_min);
+
+  /* Utility Functions */
+  lenv_add_builtin(e, "gc", &lprim_gc);
+  lenv_add_builtin(e, "memstats", &lprim_memstats);
+  lenv_add_builtin(e, "backend", &lprim_backend);
+  lenv_add_builtin(e, "tiers", &lprim_tiers);
+}
+
+/* Special Forms */
+
+/* An S-Expression headed by one of these names is not a call. Its    */
+/* head is never looked up and its cells are evaluated only as the    */
+/* form needs them, so an untaken branch is neither evaluated nor     */
+/* copied, and the expression the form's value comes from is in tail  */
+/* position whenever the form is. The names are syntax: they work    */
+/* whatever they are bound to, and are not bound to anything.         */
+/*                                                                    */
+/*   (if c a b)         a if c is true, else b                        */
+/*   (cond c a d b ...) the expression after the first true test, or  */
+/*                      () if none is                                 */
+/*   (when c a ...)     each of a ... in turn if c is true, giving    */
+/*                      the last, else ()                             */
+/*   (and? a ...)       the first false argument, else the last       */
+/*   (or? a ...)        the first true argument, else the last        */
+/*                                                                    */
+/* Conditions must be numbers and are true unless zero. An error from */
+/* any cell evaluated ends the form with it.                          */
+
+enum { LFORM_IF, LFORM_COND, LFORM_WHEN, LFORM_AND, LFORM_OR, LFORM_COUNT };
+
+char* lform_names[] = { "if", "cond", "when", "and?", "or?" };
+char* lform_syms[LFORM_COUNT];
+
+/* Returns the form the list v is written as, or -1 if it is not one */
+int lform_find(lval* v) {
+  if (v->count == 0 || lval_type(v->cell[0]) != LVAL_SYM) { return -1; }
+  if (!lform_syms[0]) {
+    for (int i = 0; i < LFORM_COUNT; i++) {
+      lform_syms[i] = lsym_intern(lform_names[i]);
+    }
+  }
+  for (int i = 0; i < LFORM_COUNT; i++) {
+    if (v->cell[0]->sym == lform_syms[i]) { return i; }
+  }
+  return -1;
+}
+
+/* Returns an error if form k cannot take argc arguments, else NULL */
+lval* lform_check(int k, int argc) {
+  switch (k) {
+    case LFORM_IF:
+      LASSERT_NUM("if", argc, 3);
+    break;
+    case LFORM_COND:
+      LASSERT(argc % 2 == 0,
+        "Function 'cond' passed a test without an expression. "
+        "Got %i arguments, Expected pairs.", argc);
+    break;
+    case LFORM_WHEN:
+      LASSERT(argc >= 1,
+        "Function 'when' passed incorrect number of arguments. "
+        "Got %i, Expected at least %i.", argc, 1);
+    break;
+  }
+  return NULL;
+}
+
+/* Tests *x, the value of argument arg of form k. Returns 1 or 0 for */
+/* a number, or -1 for an error, which replaces anything else in *x.  */
+int lform_test(int k, int arg, lval** x) {
+  switch (lval_type(*x)) {
+    case LVAL_NUM: return lval_as_num(*x) != 0;
+    case LVAL_BIG: return 1;
+    case LVAL_ERR: return -1;
+  }
+  lval* err = lval_err(
+    "Function '%s' passed incorrect type for argument %i. "
+    "Got %s, Expected %s.",
+    lform_names[k], arg, ltype_name(lval_type(*x)), ltype_name(LVAL_NUM));
+  lval_del(*x);
+  *x = err;
+  return -1;
+}
+
+/* Decides what form k, written as s, does now that cell i has given */
+/* *x, or with i == 0 before any has. Returns the next cell to        */
+/* evaluate, setting *last if its value is the form's, or -1 with the */
+/* form's value in *x. Values that are not kept are released here.    */
+int lform_step(int k, lval* s, int i, lval** x, int* last) {
+  
+  int n = s->count;
+  if (i == 0) {
+    *x = lform_check(k, n - 1);
+    if (*x) { return -1; }
+  }
+  
+  switch (k) {
+    
+    case LFORM_IF: {
+      if (i == 0) { return 1; }
+      int t = lform_test(k, 0, x);
+      if (t < 0) { return -1; }
+      lval_del(*x);
+      *last = 1;
+      return t ? 2 : 3;
+    }
+    
+    case LFORM_COND: {
+      if (i > 0) {
+        int t = lform_test(k, i - 1, x);
+        if (t < 0) { return -1; }
+        lval_del(*x);
+        if (t) {
+          *last = 1;
+          return i + 1;
+        }
+      }
+      int next = i == 0 ? 1 : i + 2;
+      if (next < n) { return next; }
+      *x = lval_sexpr();
+      return -1;
+    }
+    
+    case LFORM_WHEN:
+      if (i == 0) { return 1; }
+      if (i == 1) {
+        int t = lform_test(k, 0, x);
+        if (t < 0) { return -1; }
+        lval_del(*x);
+        if (!t || n == 2) {
+          *x = lval_sexpr();
+          return -1;
+        }
+      } else {
+        if (lval_type(*x) == LVAL_ERR) { return -1; }
+        lval_del(*x);
+      }
+    break;
+    
+    case LFORM_AND:
+    case LFORM_OR:
+      if (n == 1) {
+        *x = lval_num(k == LFORM_AND);
+        return -1;
+      }
+      if (i > 0) {
+        int t = lform_test(k, i - 1, x);
+        if (t < 0 || t == (k == LFORM_OR)) { return -1; }
+        lval_del(*x);
+      }
+    break;
+  }
+  
+  *last = i + 2 == n;
+  return i + 1;
+}
+
+/* Evaluation */
+
+/* Calls builtin f on argc borrowed arguments, by the entry for */
+/* that many arguments if it has one                             */
+lval* lprim_call(lenv* e, lprim* f, int argc, lval** argv) {
+  if (argc == 1 && f->one) { return f->one(e, argv[0]); }
+  if (argc == 2 && f->two) { return f->two(e, argv[0], argv[1]); }
+  if (f->any) { return f->any(e, argc, argv); }
+  return lval_err(
+    "Function '%s' passed incorrect number of arguments. "
+    "Got %i, Expected %i.",
+    f->name, argc, f->one ? 1 : 2);
+}
+
+/* A call in tail position of a lambda body is not made where it is  */
+/* found but left here, holding references to the function and its   */
+/* arguments, for the call running the body to make in its place. So */
+/* a chain of tail calls runs in a loop, in constant C stack.         */
+struct {
+  lval* f;
+  lval** argv;
+  int argc;
+  int cap;
+} ltail;
+
+lval* lval_arity_err(int argc, int expect) {
+  return lval_err(
+    "Function passed incorrect number of arguments. "
+    "Got %i, Expected %i.",
+    argc, expect);
+}
+
+/* Calls lambda f on argc borrowed arguments, which are bound in a */
+/* fresh frame, and then any calls its body leaves in ltail. The   */
+/* caller roots f and the arguments of the first call; later ones  */
+/* are rooted here. A frame nothing else has kept is bound again   */
+/* for the next call when the arity allows, so a loop written as   */
+/* tail recursion allocates no frames.                             */
+lval* lval_call_lambda(lval* f, int argc, lval** argv) {
+  
+  lval* formals = f->code->cell[0];
+  if (argc != formals->count) { return lval_arity_err(argc, formals->count); }
+  
+  lenv* e = lenv_frame(f->env, formals, argv);
+  int base = lgc.root_count;
+  lval* x;
+  f = lval_ref(f);
+  
+  while (!(x = lval_eval_quoted(e, f->code->cell[1], 1, 1))) {
+    
+    lval* g = ltail.f;
+    formals = g->code->cell[0];
+    if (ltail.argc != formals->count) {
+      x = lval_arity_err(ltail.argc, formals->count);
+      for (int i = 0; i < ltail.argc; i++) { lval_del(ltail.argv[i]); }
+      lval_del(g);
+      break;
+    }
+    
+    if (e->refs == 1 && e->slot_count == ltail.argc) {
+      lenv_rebind(e, g->env, formals, ltail.argv);
+    } else {
+      lenv* next = lenv_frame(g->env, formals, ltail.argv);
+      for (int i = 0; i < ltail.argc; i++) { lval_del(ltail.argv[i]); }
+      lenv_release(e);
+      e = next;
+    }
+    lval_del(f);
+    f = g;
+    
+    lgc.root_count = base;
+    lgc_push(f);
+    for (int i = 0; i < e->slot_count; i++) { lgc_push(e->vals[i]); }
+  }
+  
+  lgc.root_count = base;
+  lenv_release(e);
+  lval_del(f);
+  return x;
+}
+
+lval* lval_call(lenv* e, lval* f, int argc, lval** argv) {
+  
+  if (lval_type(f) == LVAL_LAMBDA) { return lval_call_lambda(f, argc, argv); }
+  
+  /* Ensure first element is a function after evaluation */
+  if (lval_type(f) != LVAL_FUN) {
+    return lval_err(
+      "S-Expression starts with incorrect type. "
+      "Got %s, Expected %s.",
+      ltype_name(lval_type(f)), ltype_name(LVAL_FUN));
+  }
+  return lprim_call(e, f->fun, argc, argv);
+}
+
+/* Checks a call is one that tail position changes */
+int lval_is_tail(lval* f, int argc, lval** argv) {
+  if (lval_type(f) == LVAL_LAMBDA) { return 1; }
+  return lval_type(f) == LVAL_FUN && f->fun == &lprim_eval
+    && argc == 1 && lval_type(argv[0]) == LVAL_QEXPR;
+}
+
+/* Makes a call in tail position. A call to a lambda is left in ltail */
+/* and NULL returned, and eval runs its argument in tail position.    */
+lval* lval_call_tail(lenv* e, lval* f, int argc, lval** argv) {
+  
+  if (!lval_is_tail(f, argc, argv)) { return lval_call(e, f, argc, argv); }
+  
+  if (lval_type(f) == LVAL_LAMBDA) {
+    if (argc > ltail.cap) {
+      ltail.cap = argc;
+      ltail.argv = realloc(ltail.argv, sizeof(lval*) * argc);
+    }
+    ltail.f = lval_ref(f);
+    for (int i = 0; i < argc; i++) { ltail.argv[i] = lval_ref(argv[i]); }
+    ltail.argc = argc;
+    return NULL;
+  }
+  
+  return lval_eval_quoted(e, argv[0], argv[0]->refs >= 2, 1);
+}
+
+/* An S-Expression being evaluated and the cell it is up to, which is */
+/* -1 before the first. Open lists live on a heap stack rather than    */
+/* the C stack, so nesting is limited only by memory and not by how    */
+/* deep C can recurse. Lambda calls that are not tail calls still      */
+/* recurse, as far as lcall allows, as do the passes that fold,        */
+/* address and compile source, which is refused past LREAD_DEPTH      */
+/* levels before it is parsed. A special form is also the form it is.  */
+typedef struct {
+  lval* v;
+  int i;
+  int form;
+} leval_frame;
+
+struct {
+  leval_frame* frames;
+  int count;
+  int cap;
+} leval;
+
+void leval_push(lval* v, int form) {
+  if (leval.count == leval.cap) {
+    leval.cap = leval.cap ? leval.cap * 2 : 64;
+    leval.frames = realloc(leval.frames, sizeof(leval_frame) * leval.cap);
+  }
+  leval.frames[leval.count].v = v;
+  leval.frames[leval.count].i = form < 0 ? -1 : 0;
+  leval.frames[leval.count].form = form;
+  leval.count++;
+}
+
+/* Finishes an S-Expression whose cells have all been evaluated */
+lval* lval_apply_sexpr(lenv* e, lval* v, int tail) {
+  
+  for (int i = 0; i < v->count; i++) {
+    if (lval_type(v->cell[i]) == LVAL_ERR) { return lval_take(v, i); }
+  }
+  
+  if (v->count == 0) { return v; }  
+  if (v->count == 1) { return lval_take(v, 0); }
+  
+  /* The function and its arguments stay in v, which roots them */
+  lgc_push(v);
+  lval* x = tail
+    ? lval_call_tail(e, v->cell[0], v->count - 1, v->cell + 1)
+    : lval_call(e, v->cell[0], v->count - 1, v->cell + 1);
+  lgc_pop();
+  lval_del(v);
+  return x;
+}
+
+lval* lval_eval(lenv* e, lval* v) {
+  return lval_walk(e, v, 0);
+}
+
+/* Builtins may evaluate again, so each call only unwinds the */
+/* frames above the ones it found on entry. In tail position  */
+/* the call v makes may be left pending.                      */
+lval* lval_walk(lenv* e, lval* v, int tail) {
+  
+  int base = leval.count;
+  
+  while (1) {
+    
+    if (lgc_safepoint_due()) {
+      lgc_push(v);
+      lgc_safepoint();
+      lgc_pop();
+    }
+    
+    if (lval_type(v) == LVAL_SYM) {
+      lval* x = lenv_get(e, v);
+      lval_del(v);
+      v = x;
+    } else if (lval_type(v) == LVAL_SEXPR) {
+      
+      /* Cells are replaced in place so the list must not be shared, */
+      /* but a special form only reads its cells and leaves them be   */
+      int form = lform_find(v);
+      if (form < 0) { v = lval_own(v); }
+      
+      if (v->count > 0) {
+        lgc_push(v);
+        leval_push(v, form);
+        v = NULL;
+      }
+    }
+    
+    /* v is a value, so store it and move to the next open cell. Each */
+    /* cell is cleared while it is evaluated so a collection never    */
+    /* marks through a child that the evaluation has consumed.        */
+    int descend = 0;
+    while (leval.count > base) {
+      leval_frame* f = &leval.frames[leval.count-1];
+      lval* s = f->v;
+      int form = f->form;
+      int last = 0;
+      int next;
+      
+      if (form >= 0) {
+        next = lform_step(form, s, f->i, &v, &last);
+      } else {
+        if (f->i >= 0) {
+          s->cell[f->i] = v;
+          lgc_barrier(s, v);
+        }
+        next = f->i + 1 < s->count ? f->i + 1 : -1;
+      }
+      
+      if (next >= 0) {
+        if (form >= 0) {
+          v = lval_ref(s->cell[next]);
+        } else {
+          v = s->cell[next];
+          s->cell[next] = NULL;
+        }
+        
+        /* The form's value is that of the cell, which takes its place */
+        if (last) {
+          leval.count--;
+          lgc_pop();
+          lval_del(s);
+        } else {
+          f->i = next;
+        }
+        descend = 1;
+        break;
+      }
+      
+      leval.count--;
+      lgc_pop();
+      if (form >= 0) {
+        lval_del(s);
+      } else {
+        v = lval_apply_sexpr(e, s, tail && leval.count == base);
+      }
+    }
+    
+    if (!descend) { return v; }
+  }
+}
+
+/* Bytecode */
+
+/* An S-Expression can be compiled once into a flat instruction array */
+/* for a stack machine, so running it again neither copies nor frees  */
+/* any of the tree. Operands live on the collector's root stack, and   */
+/* the code borrows its constants and symbols from the expression it   */
+/* was compiled from, which must stay alive and unchanged meanwhile.   */
+/*                                                                     */
+/* Code for shared Q-Expressions passed to eval is cached by node. An  */
+/* entry is dropped when its node is freed or made mutable by lval_own */
+/* and code that borrows nursery nodes is never cached, as minor       */
+/* collections move those.                                             */
+
+/*                                                                     */
+/* Special forms compile to jumps. Instructions are an opcode and its  */
+/* operands, which for a test give the form and argument it is, for    */
+/* errors, and where to jump.                                          */
+
+enum {
+  LOP_CONST, LOP_LOAD, LOP_CALL, LOP_TAIL, LOP_RETURN, LOP_JUMP,
+  LOP_TEST, LOP_SHORT, LOP_DROP, LOP_NIL, LOP_WALK
+};
+
+struct lcode {
+  int* ops;
+  int count;
+  int cap;
+  lval** consts;
+  lic* ics;
+  int const_count;
+  int const_cap;
+  int sp;
+  int depth;
+  int young;
+};
+
+/* Appends one word of code, returning where it is so a jump can be */
+/* patched once its target is known                                  */
+int lcode_word(lcode* c, int x) {
+  if (c->count == c->cap) {
+    c->cap = c->cap ? c->cap * 2 : 16;
+    c->ops = realloc(c->ops, sizeof(int) * c->cap);
+  }
+  c->ops[c->count] = x;
+  return c->count++;
+}
+
+void lcode_emit(lcode* c, int op, int arg) {
+  lcode_word(c, op);
+  lcode_word(c, arg);
+}
+
+int lcode_const(lcode* c, lval* v) {
+  if (c->const_count == c->const_cap) {
+    c->const_cap = c->const_cap ? c->const_cap * 2 : 8;
+    c->consts = realloc(c->consts, sizeof(lval*) * c->const_cap);
+    c->ics = realloc(c->ics, sizeof(lic) * c->const_cap);
+  }
+  if (!lval_is_fix(v) && lval_in_nursery(v)) { c->young = 1; }
+  lic empty = { NULL, 0, 0 };
+  c->consts[c->const_count] = v;
+  c->ics[c->const_count] = empty;
+  return c->const_count++;
+}
+
+/* Tracks the operand stack height so the machine can reserve it */
+void lcode_stack(lcode* c, int n) {
+  c->sp += n;
+  if (c->sp > c->depth) { c->depth = c->sp; }
+}
+
+void lcode_form(lcode* c, lval* v, int k, int tail);
+
+void lcode_expr(lcode* c, lval* v) {
+  switch (lval_type(v)) {
+    case LVAL_SYM:
+      lcode_emit(c, LOP_LOAD, lcode_const(c, v));
+      lcode_stack(c, 1);
+    break;
+    case LVAL_SEXPR: {
+      int k = lform_find(v);
+      if (k >= 0) {
+        lcode_form(c, v, k, 0);
+        break;
+      }
+      for (int i = 0; i < v->count; i++) {
+        lcode_expr(c, v->cell[i]);
+      }
+      lcode_emit(c, LOP_CALL, v->count);
+      lcode_stack(c, 1 - v->count);
+    }
+    break;
+    default:
+      lcode_emit(c, LOP_CONST, lcode_const(c, v));
+      lcode_stack(c, 1);
+    break;
+  }
+}
+
+/* Compiles the cells of v as an S-Expression in tail position, so */
+/* every path through it returns its value                         */
+void lcode_tail(lcode* c, lval* v) {
+  int k = lform_find(v);
+  if (k >= 0) {
+    lcode_form(c, v, k, 1);
+    return;
+  }
+  for (int i = 0; i < v->count; i++) {
+    lcode_expr(c, v->cell[i]);
+  }
+  lcode_emit(c, LOP_TAIL, v->count);
+  lcode_stack(c, 1 - v->count);
+}
+
+/* Compiles an expression whose value is that of a form */
+void lcode_branch(lcode* c, lval* v, int tail) {
+  if (!tail) {
+    lcode_expr(c, v);
+  } else if (lval_type(v) == LVAL_SEXPR) {
+    lcode_tail(c, v);
+  } else {
+    lcode_expr(c, v);
+    lcode_word(c, LOP_RETURN);
+  }
+}
+
+/* Emits a test of argument arg of form k, returning where to patch */
+/* the jump taken when it is false                                   */
+int lcode_test(lcode* c, int k, int arg, int* ends, int* end_count) {
+  lcode_word(c, LOP_TEST);
+  lcode_word(c, k);
+  lcode_word(c, arg);
+  int skip = lcode_word(c, 0);
+  ends[(*end_count)++] = lcode_word(c, 0);
+  lcode_stack(c, -1);
+  return skip;
+}
+
+/* Compiles form k, written as v. Every path leaves the form's value */
+/* on the stack at its end, or in tail position returns it, errors   */
+/* included. Paths that leave a value are counted once on the stack. */
+void lcode_form(lcode* c, lval* v, int k, int tail) {
+  
+  /* A form that is not well formed is left to the tree walker */
+  lval* err = lform_check(k, v->count - 1);
+  if (err) {
+    lval_del(err);
+    lcode_emit(c, LOP_WALK, lcode_const(c, v));
+    lcode_stack(c, 1);
+    if (tail) { lcode_word(c, LOP_RETURN); }
+    return;
+  }
+  
+  int n = v->count;
+  int* ends = malloc(sizeof(int) * 2 * n);
+  int end_count = 0;
+  
+  switch (k) {
+    
+    case LFORM_IF: {
+      lcode_expr(c, v->cell[1]);
+      int skip = lcode_test(c, k, 0, ends, &end_count);
+      lcode_branch(c, v->cell[2], tail);
+      if (!tail) {
+        lcode_word(c, LOP_JUMP);
+        ends[end_count++] = lcode_word(c, 0);
+      }
+      lcode_stack(c, -1);
+      c->ops[skip] = c->count;
+      lcode_branch(c, v->cell[3], tail);
+    }
+    break;
+    
+    case LFORM_COND:
+    case LFORM_WHEN: {
+      int skip = -1;
+      for (int i = 1; i < n; i += 2) {
+        lcode_expr(c, v->cell[i]);
+        skip = lcode_test(c, k, k == LFORM_COND ? i - 1 : 0, ends, &end_count);
+        if (k == LFORM_WHEN) { break; }
+        
+        lcode_branch(c, v->cell[i+1], tail);
+        if (!tail) {
+          lcode_word(c, LOP_JUMP);
+          ends[end_count++] = lcode_word(c, 0);
+        }
+        lcode_stack(c, -1);
+        c->ops[skip] = c->count;
+        skip = -1;
+      }
+      
+      /* The body of when runs with errors ending it early */
+      if (k == LFORM_WHEN && n > 2) {
+        for (int i = 2; i < n - 1; i++) {
+          lcode_expr(c, v->cell[i]);
+          lcode_word(c, LOP_DROP);
+          ends[end_count++] = lcode_word(c, 0);
+          lcode_stack(c, -1);
+        }
+        lcode_branch(c, v->cell[n-1], tail);
+        if (!tail) {
+          lcode_word(c, LOP_JUMP);
+          ends[end_count++] = lcode_word(c, 0);
+        }
+        lcode_stack(c, -1);
+      }
+      
+      if (skip >= 0) { c->ops[skip] = c->count; }
+      lcode_word(c, LOP_NIL);
+      lcode_stack(c, 1);
+      if (tail) { lcode_word(c, LOP_RETURN); }
+    }
+    break;
+    
+    case LFORM_AND:
+    case LFORM_OR:
+      if (n == 1) {
+        lcode_emit(c, LOP_CONST, lcode_const(c, lval_num(k == LFORM_AND)));
+        lcode_stack(c, 1);
+        if (tail) { lcode_word(c, LOP_RETURN); }
+        break;
+      }
+      for (int i = 1; i < n - 1; i++) {
+        lcode_expr(c, v->cell[i]);
+        lcode_word(c, LOP_SHORT);
+        lcode_word(c, k);
+        lcode_word(c, i - 1);
+        ends[end_count++] = lcode_word(c, 0);
+        lcode_stack(c, -1);
+      }
+      lcode_branch(c, v->cell[n-1], tail);
+    break;
+  }
+  
+  /* Errors, and in tail position only errors, come out here */
+  for (int i = 0; i < end_count; i++) { c->ops[ends[i]] = c->count; }
+  if (tail && end_count) { lcode_word(c, LOP_RETURN); }
+  free(ends);
+}
+
+/* Compiles the cells of v as the S-Expression they would be if evaluated */
+lcode* lcode_compile(lval* v) {
+  lcode* c = calloc(1, sizeof(lcode));
+  lcode_tail(c, v);
+  return c;
+}
+
+void lcode_del(lcode* c) {
+  free(c->ops);
+  free(c->consts);
+  free(c->ics);
+  free(c);
+}
+
+/* If any value on the root stack from base up is an error, releases */
+/* the others, cuts the stack to base and returns the first error.    */
+/* Otherwise returns NULL.                                            */
+lval* lvm_error(int base) {
+  int n = lgc.root_count - base;
+  lval** xs = &lgc.roots[base];
+  
+  for (int i = 0; i < n; i++) {
+    if (lval_type(xs[i]) == LVAL_ERR) {
+      lval* err = xs[i];
+      for (int j = 0; j < n; j++) {
+        if (j != i) { lval_del(xs[j]); }
+      }
+      lgc.root_count = base;
+      return err;
+    }
+  }
+  return NULL;
+}
+
+/* Releases the values on the root stack from base up */
+void lvm_drop(int base) {
+  while (lgc.root_count > base) { lval_del(lgc.roots[--lgc.root_count]); }
+}
+
+#define LVM_ARGS 8
+
+/* Calls f with the values on the root stack from base up, which */
+/* stay there as roots, then releases them                      */
+lval* lvm_apply(lenv* e, lprim* f, int base) {
+  
+  lgc_safepoint();
+  
+  /* The root stack may move while f runs, so f gets a copy of */
+  /* the arguments that will not                                */
+  int argc = lgc.root_count - base;
+  lval* args[LVM_ARGS];
+  lval** argv = argc <= LVM_ARGS ? args : malloc(sizeof(lval*) * argc);
+  memcpy(argv, &lgc.roots[base], sizeof(lval*) * argc);
+  
+  lval* x = lprim_call(e, f, argc, argv);
+  
+  if (argv != args) { free(argv); }
+  lvm_drop(base);
+  return x;
+}
+
+/* Calls the top n values of the root stack as an S-Expression */
+lval* lvm_call(lenv* e, int n) {
+  int base = lgc.root_count - n;
+  
+  if (n == 0) { return lval_sexpr(); }
+  if (n == 1) { return lgc.roots[--lgc.root_count]; }
+  
+  lval* err = lvm_error(base);
+  if (err) { return err; }
+  
+  lval* f = lgc.roots[base];
+  if (lval_type(f) != LVAL_FUN) {
+    lval* x = lval_call(e, f, n - 1, &lgc.roots[base + 1]);
+    lvm_drop(base);
+    return x;
+  }
+  
+  lval* x = lvm_apply(e, f->fun, base + 1);
+  lvm_drop(base);
+  return x;
+}
+
+/* As lvm_call, for a call in tail position */
+lval* lvm_tail(lenv* e, int n) {
+  int base = lgc.root_count - n;
+  
+  if (n < 2 || !lval_is_tail(lgc.roots[base], n - 1, &lgc.roots[base + 1])) {
+    return lvm_call(e, n);
+  }
+  
+  lval* err = lvm_error(base);
+  if (err) { return err; }
+  
+  lval* x = lval_call_tail(e, lgc.roots[base], n - 1, &lgc.roots[base + 1]);
+  lvm_drop(base);
+  return x;
+}
+
+lval* lvm_run(lenv* e, lcode* c, int tail) {
+  
+  /* Dispatch by computed goto, indexed by opcode */
+  static void* labels[] = {
+    &&op_const, &&op_load, &&op_call, &&op_tail, &&op_return, &&op_jump,
+    &&op_test, &&op_short, &&op_drop, &&op_nil, &&op_walk
+  };
+  #define LVM_NEXT() goto *labels[*ip++]
+  #define LVM_PUSH(x) (lgc.roots[lgc.root_count++] = (x))
+  
+  /* Reserve the whole operand stack up front */
+  while (lgc.root_count + c->depth > lgc.root_cap) {
+    lgc.root_cap = lgc.root_cap ? lgc.root_cap * 2 : 64;
+    lgc.roots = realloc(lgc.roots, sizeof(lval*) * lgc.root_cap);
+  }
+  
+  int* ip = c->ops;
+  LVM_NEXT();
+  
+  op_const:
+    LVM_PUSH(lval_ref(c->consts[*ip++]));
+    LVM_NEXT();
+  
+  op_load: {
+    int i = *ip++;
+    LVM_PUSH(lic_get(&c->ics[i], e, c->consts[i]));
+    LVM_NEXT();
+  }
+  
+  op_call: {
+    lval* x = lvm_call(e, *ip++);
+    LVM_PUSH(x);
+    LVM_NEXT();
+  }
+  
+  op_tail: {
+    int n = *ip++;
+    return tail ? lvm_tail(e, n) : lvm_call(e, n);
+  }
+  
+  op_return:
+    return lgc.roots[--lgc.root_count];
+  
+  op_jump:
+    ip = c->ops + *ip;
+    LVM_NEXT();
+  
+  /* Operands form, argument, false target and error target. The */
+  /* value tested is dropped unless it ends the form.             */
+  op_test: {
+    lval** x = &lgc.roots[lgc.root_count-1];
+    int t = lform_test(ip[0], ip[1], x);
+    if (t < 0) {
+      ip = c->ops + ip[3];
+      LVM_NEXT();
+    }
+    lval_del(*x);
+    lgc.root_count--;
+    ip = t ? ip + 4 : c->ops + ip[2];
+    LVM_NEXT();
+  }
+  
+  /* Operands form, argument and target, for and? and or? */
+  op_short: {
+    lval** x = &lgc.roots[lgc.root_count-1];
+    int t = lform_test(ip[0], ip[1], x);
+    if (t < 0 || t == (ip[0] == LFORM_OR)) {
+      ip = c->ops + ip[2];
+      LVM_NEXT();
+    }
+    lval_del(*x);
+    lgc.root_count--;
+    ip += 3;
+    LVM_NEXT();
+  }
+  
+  op_drop: {
+    lval* x = lgc.roots[lgc.root_count-1];
+    if (lval_type(x) == LVAL_ERR) {
+      ip = c->ops + *ip;
+      LVM_NEXT();
+    }
+    lval_del(x);
+    lgc.root_count--;
+    ip++;
+    LVM_NEXT();
+  }
+  
+  op_nil:
+    LVM_PUSH(lval_sexpr());
+    LVM_NEXT();
+  
+  op_walk: {
+    lval* x = lval_walk(e, lval_ref(c->consts[*ip++]), 0);
+    LVM_PUSH(x);
+    LVM_NEXT();
+  }
+  
+  #undef LVM_NEXT
+  #undef LVM_PUSH
+}
 
-lval* lval_eval(lenv* e, lval* v);
+/* Compiles and runs v, an S-Expression that is consumed */
+lval* lvm_eval(lenv* e, lval* v) {
+  lcode* c = lcode_compile(v);
+  lgc_push(v);
+  lval* x = lvm_run(e, c, 0);
+  lgc_pop();
+  lcode_del(c);
+  lval_del(v);
+  return x;
+}
+
+/* Closures */
+
+/* An alternative backend that compiles an expression once into a tree */
+/* of C callbacks. Each node holds the function that evaluates it and  */
+/* its operands, so running it again walks no lval and re-decides      */
+/* nothing. Calls through a symbol bound to a builtin are resolved at  */
+/* compile time, and arithmetic goes straight to its operator, guarded */
+/* by the environment version so a rebinding falls back to the lookup. */
+/* Like bytecode, a closure borrows the expression it was compiled     */
+/* from.                                                               */
+
+typedef lval*(*lclofn)(lenv*, lclo*);
+typedef struct ljit ljit;
+
+struct lclo {
+  lclofn fn;
+  lval* val;
+  lprim* fun;
+  int op;
+  lenv* env;
+  long version;
+  int count;
+  lclo** kids;
+  int hits;
+  ljit* jit;
+  lic ic;
+};
+
+/* Native code for hot arithmetic, see below */
+#define LJIT_HOT 16
+
+ljit* ljit_compile(lenv* e, lclo* c);
+lval* ljit_run(lenv* e, ljit* j);
+void ljit_del(ljit* j);
+
+lval* lclo_const(lenv* e, lclo* c) {
+  return lval_ref(c->val);
+}
+
+lval* lclo_load(lenv* e, lclo* c) {
+  return lic_get(&c->ic, e, c->val);
+}
+
+/* Evaluates the children of c from index i onto the root stack */
+void lclo_push_kids(lenv* e, lclo* c, int i) {
+  for (; i < c->count; i++) {
+    lclo* k = c->kids[i];
+    lgc_push(k->fn(e, k));
+  }
+}
+
+lval* lclo_sexpr(lenv* e, lclo* c) {
+  lclo_push_kids(e, c, 0);
+  return lvm_call(e, c->count);
+}
+
+/* Checks the head of c still names the builtin it was resolved to, */
+/* taking on the current version if it does after a rebinding. Run   */
+/* in a frame, an addressed head is found where it was unless it is  */
+/* a parameter, which is bound afresh for each call.                 */
+int lclo_resolved(lenv* e, lclo* c) {
+  lval* k = c->kids[0]->val;
+  e = lenv_home(e, k);
+  if (e != c->env) { return 0; }
+  if (e->version == c->version) { return 1; }
+  
+  lval* f = lenv_peek(e, k->sym);
+  if (!f || lval_type(f) != LVAL_FUN || f->fun != c->fun) { return 0; }
+  
+  c->version = e->version;
+  return 1;
+}
+
+/* A call whose head named a builtin when it was compiled */
+lval* lclo_builtin(lenv* e, lclo* c) {
+  if (!lclo_resolved(e, c)) { return lclo_sexpr(e, c); }
+  
+  int base = lgc.root_count;
+  lclo_push_kids(e, c, 1);
+  
+  lval* err = lvm_error(base);
+  if (err) { return err; }
+  return lvm_apply(e, c->fun, base);
+}
+
+/* An arithmetic call, folded straight off the stack when every */
+/* argument is a number                                         */
+lval* lclo_arith(lenv* e, lclo* c) {
+  if (!lclo_resolved(e, c)) { return lclo_sexpr(e, c); }
+  
+  #ifdef VHISP_JIT
+  /* Hot arithmetic runs as native code while its guards hold */
+  if (!c->jit && ++c->hits == LJIT_HOT) {
+    c->jit = ljit_compile(e, c);
+    if (c->jit) { ltier.compiles++; }
+  }
+  if (c->jit) {
+    lval* x = ljit_run(e, c->jit);
+    if (x) {
+      ltier.native++;
+      return x;
+    }
+  }
+  #endif
+  
+  int base = lgc.root_count;
+  lclo_push_kids(e, c, 1);
+  
+  lval** xs = &lgc.roots[base];
+  int n = c->count - 1;
+  for (int i = 0; i < n; i++) {
+    if (lval_type(xs[i]) != LVAL_NUM) {
+      
+      /* Let the builtin report errors and bad types as usual */
+      lval* err = lvm_error(base);
+      if (err) { return err; }
+      return lvm_apply(e, c->fun, base);
+    }
+  }
+  
+  lval* x = larith_fold(c->op, xs, n);
+  for (int i = 0; i < n; i++) { lval_del(xs[i]); }
+  lgc.root_count = base;
+  return x;
+}
+
+/* An arithmetic call on constants, folded to a small integer when it */
+/* was compiled. The value holds while every head in it still names  */
+/* the same builtin; otherwise the call is made as usual.            */
+lval* lclo_folded(lenv* e, lclo* c);
+
+int lclo_refold(lenv* e, lclo* c) {
+  for (int i = 1; i < c->count; i++) {
+    if (c->kids[i]->fn == lclo_folded && !lclo_refold(e, c->kids[i])) { return 0; }
+  }
+  return lclo_resolved(e, c);
+}
+
+lval* lclo_folded(lenv* e, lclo* c) {
+  if (e == c->env && e->version == c->version) { return c->val; }
+  if (lclo_refold(e, c)) { return c->val; }
+  return lclo_sexpr(e, c);
+}
+
+/* Folds an arithmetic node whose arguments are all constant numbers */
+void lclo_fold(lclo* c) {
+  int n = c->count - 1;
+  lval** xs = malloc(sizeof(lval*) * n);
+  for (int i = 0; i < n; i++) {
+    lclo* k = c->kids[i+1];
+    int constant = k->fn == lclo_folded
+      || (k->fn == lclo_const && lval_type(k->val) == LVAL_NUM);
+    if (!constant) {
+      free(xs);
+      return;
+    }
+    xs[i] = k->val;
+  }
+  
+  /* Only keep results that need no node, so nothing moves or is freed */
+  if (larith_safe(c->op, xs, n)) {
+    lval* x = larith_fold(c->op, xs, n);
+    if (lval_is_fix(x)) {
+      c->fn = lclo_folded;
+      c->val = x;
+    } else {
+      lval_del(x);
+    }
+  }
+  free(xs);
+}
+
+/* A special form, with its kind in op and a child for each cell. The */
+/* head's child is never run.                                         */
+lval* lclo_form_run(lenv* e, lclo* c, int tail) {
+  
+  int k = c->op;
+  int n = c->count;
+  lval* x;
+  int t;
+  
+  switch (k) {
+    
+    case LFORM_IF:
+      x = lclo_run(e, c->kids[1], 0);
+      t = lform_test(k, 0, &x);
+      if (t < 0) { return x; }
+      lval_del(x);
+      return lclo_run(e, c->kids[t ? 2 : 3], tail);
+    
+    case LFORM_COND:
+      for (int i = 1; i < n; i += 2) {
+        x = lclo_run(e, c->kids[i], 0);
+        t = lform_test(k, i - 1, &x);
+        if (t < 0) { return x; }
+        lval_del(x);
+        if (t) { return lclo_run(e, c->kids[i+1], tail); }
+      }
+      return lval_sexpr();
+    
+    case LFORM_WHEN:
+      x = lclo_run(e, c->kids[1], 0);
+      t = lform_test(k, 0, &x);
+      if (t < 0) { return x; }
+      lval_del(x);
+      if (!t || n == 2) { return lval_sexpr(); }
+      for (int i = 2; i < n - 1; i++) {
+        x = lclo_run(e, c->kids[i], 0);
+        if (lval_type(x) == LVAL_ERR) { return x; }
+        lval_del(x);
+      }
+      return lclo_run(e, c->kids[n-1], tail);
+    
+    default:
+      if (n == 1) { return lval_num(k == LFORM_AND); }
+      for (int i = 1; i < n - 1; i++) {
+        x = lclo_run(e, c->kids[i], 0);
+        t = lform_test(k, i - 1, &x);
+        if (t < 0 || t == (k == LFORM_OR)) { return x; }
+        lval_del(x);
+      }
+      return lclo_run(e, c->kids[n-1], tail);
+  }
+}
+
+lval* lclo_form(lenv* e, lclo* c) {
+  return lclo_form_run(e, c, 0);
+}
+
+/* A special form that is not well formed, left to the tree walker */
+lval* lclo_walk(lenv* e, lclo* c) {
+  return lval_walk(e, lval_ref(c->val), 0);
+}
+
+/* In tail position only a call whose head was not resolved to a */
+/* builtin, or was resolved to eval, is made differently, along  */
+/* with the branches of a special form                           */
+lval* lclo_run(lenv* e, lclo* c, int tail) {
+  if (tail && (c->fn == lclo_sexpr || (c->fn == lclo_builtin && c->fun == &lprim_eval))) {
+    lclo_push_kids(e, c, 0);
+    return lvm_tail(e, c->count);
+  }
+  if (tail && c->fn == lclo_form) { return lclo_form_run(e, c, 1); }
+  return c->fn(e, c);
+}
+
+lclo* lclo_node(lclofn fn, lval* val, int count, int* young) {
+  lclo* c = calloc(1, sizeof(lclo));
+  c->fn = fn;
+  c->val = val;
+  c->count = count;
+  c->kids = count ? malloc(sizeof(lclo*) * count) : NULL;
+  if (val && !lval_is_fix(val) && lval_in_nursery(val)) { *young = 1; }
+  return c;
+}
+
+lclo* lclo_expr(lenv* e, lval* v, int* young);
+
+/* Compiles the cells of v as the S-Expression they would be if evaluated */
+lclo* lclo_compile(lenv* e, lval* v, int* young) {
+  
+  int k = lform_find(v);
+  if (k >= 0) {
+    lval* err = lform_check(k, v->count - 1);
+    if (err) {
+      lval_del(err);
+      return lclo_node(lclo_walk, v, 0, young);
+    }
+  }
+  
+  lclo* c = lclo_node(k >= 0 ? lclo_form : lclo_sexpr, NULL, v->count, young);
+  for (int i = 0; i < v->count; i++) {
+    c->kids[i] = lclo_expr(e, v->cell[i], young);
+  }
+  
+  if (k >= 0) {
+    c->op = k;
+    return c;
+  }
+  
+  /* Resolve a head symbol that is currently bound to a builtin */
+  if (v->count < 2 || lval_type(v->cell[0]) != LVAL_SYM) { return c; }
+  lenv* scope = lenv_home(e, v->cell[0]);
+  lval* f = scope ? lenv_load(e, v->cell[0]) : NULL;
+  if (!f || lval_type(f) != LVAL_FUN) { return c; }
+  
+  c->fun = f->fun;
+  c->env = scope;
+  c->version = scope->version;
+  c->op = larith_op(c->fun);
+  c->fn = c->op < 0 ? lclo_builtin : lclo_arith;
+  if (c->op >= 0) { lclo_fold(c); }
+  return c;
+}
+
+lclo* lclo_expr(lenv* e, lval* v, int* young) {
+  switch (lval_type(v)) {
+    case LVAL_SYM: return lclo_node(lclo_load, v, 0, young);
+    case LVAL_SEXPR: return lclo_compile(e, v, young);
+    default: return lclo_node(lclo_const, v, 0, young);
+  }
+}
+
+void lclo_del(lclo* c) {
+  for (int i = 0; i < c->count; i++) {
+    lclo_del(c->kids[i]);
+  }
+  #ifdef VHISP_JIT
+  if (c->jit) { ljit_del(c->jit); }
+  #endif
+  free(c->kids);
+  free(c);
+}
+
+/* Compiles and runs v, an S-Expression that is consumed */
+lval* lclo_eval(lenv* e, lval* v) {
+  int young = 0;
+  lclo* c = lclo_compile(e, v, &young);
+  lgc_push(v);
+  lval* x = lclo_run(e, c, 0);
+  lgc_pop();
+  lclo_del(c);
+  lval_del(v);
+  return x;
+}
+
+/* Native Code */
+
+/* On x86-64 an arithmetic closure that has run LJIT_HOT times is      */
+/* compiled to machine code when its whole tree is arithmetic builtins */
+/* over number constants and symbols. Operands are kept on the native  */
+/* stack. Symbols are loaded and checked to be numbers before entering */
+/* the code, and the code itself bails out on anything the builtins   */
+/* would report or trap on, such as division by zero. Every nested     */
+/* head and folded constant the code was built on is checked again     */
+/* too, as a frame may bind any of those names. Either way the closure */
+/* is then run as usual, which is safe as the tree is pure.            */
+
+#ifdef VHISP_JIT
+
+#define LJIT_MAX_SYMS 64
+
+typedef long(*ljitfn)(long*, int*);
+
+struct ljit {
+  ljitfn fn;
+  void* mem;
+  size_t size;
+  lval** syms;
+  int sym_count;
+  lclo** heads;
+  int head_count;
+};
+
+typedef struct {
+  unsigned char* buf;
+  int count;
+  int cap;
+  int* fails;
+  int fail_count;
+  int fail_cap;
+  int depth;
+  lval** syms;
+  int sym_count;
+  lclo** heads;
+  int head_count;
+  int head_cap;
+} ljit_asm;
+
+void ljit_bytes(ljit_asm* a, void* bytes, int n) {
+  if (a->count + n > a->cap) {
+    a->cap = a->cap ? a->cap * 2 : 256;
+    if (a->cap < a->count + n) { a->cap = a->count + n; }
+    a->buf = realloc(a->buf, a->cap);
+  }
+  memcpy(a->buf + a->count, bytes, n);
+  a->count += n;
+}
+
+#define LJIT_EMIT(a, ...) do { \
+  unsigned char lbytes_[] = { __VA_ARGS__ }; \
+  ljit_bytes(a, lbytes_, sizeof(lbytes_)); \
+} while (0)
+
+void ljit_imm64(ljit_asm* a, long x) {
+  ljit_bytes(a, &x, 8);
+}
+
+/* Emits a rel32 jump to the bail-out path, patched once it is placed */
+void ljit_fail(ljit_asm* a, unsigned char cc) {
+  LJIT_EMIT(a, 0x0f, cc);
+  if (a->fail_count == a->fail_cap) {
+    a->fail_cap = a->fail_cap ? a->fail_cap * 2 : 8;
+    a->fails = realloc(a->fails, sizeof(int) * a->fail_cap);
+  }
+  a->fails[a->fail_count++] = a->count;
+  int rel = 0;
+  ljit_bytes(a, &rel, 4);
+}
+
+int ljit_expr(ljit_asm* a, lenv* e, lclo* c);
+
+/* The step of **, called from native code, which bails out if it fails */
+long ljit_pow(long x, long y, int* fail) {
+  long r;
+  if (!lpow_step(x, y, &r)) {
+    *fail = 1;
+    return 0;
+  }
+  return r;
+}
+
+/* Folds the arguments of an arithmetic node into rax, as larith_fold */
+int ljit_arith(ljit_asm* a, lenv* e, lclo* c) {
+  
+  if (!ljit_expr(a, e, c->kids[1])) { return 0; }
+  
+  if (c->op == LARITH_SUB && c->count == 2) {
+    LJIT_EMIT(a, 0x58, 0x48, 0xf7, 0xd8);              /* pop rax; neg rax */
+    ljit_fail(a, 0x80);                                /* jo fail */
+    LJIT_EMIT(a, 0x50);                                /* push rax */
+  }
+  
+  for (int i = 2; i < c->count; i++) {
+    if (!ljit_expr(a, e, c->kids[i])) { return 0; }
+    LJIT_EMIT(a, 0x59, 0x58);                          /* pop rcx; pop rax */
+    a->depth -= 2;
+    
+    switch (c->op) {
+      case LARITH_ADD: LJIT_EMIT(a, 0x48, 0x01, 0xc8); ljit_fail(a, 0x80); break;
+      case LARITH_SUB: LJIT_EMIT(a, 0x48, 0x29, 0xc8); ljit_fail(a, 0x80); break;
+      case LARITH_MUL: LJIT_EMIT(a, 0x48, 0x0f, 0xaf, 0xc1); ljit_fail(a, 0x80); break;
+      case LARITH_AND: LJIT_EMIT(a, 0x48, 0x21, 0xc8); break;
+      case LARITH_OR:  LJIT_EMIT(a, 0x48, 0x09, 0xc8); break;
+      case LARITH_MIN: LJIT_EMIT(a, 0x48, 0x39, 0xc8, 0x48, 0x0f, 0x4f, 0xc1); break;
+      case LARITH_MAX: LJIT_EMIT(a, 0x48, 0x39, 0xc8, 0x48, 0x0f, 0x4c, 0xc1); break;
+      case LARITH_DIV:
+      case LARITH_MOD:
+        LJIT_EMIT(a, 0x48, 0x85, 0xc9);                /* test rcx, rcx */
+        ljit_fail(a, 0x84);                            /* jz fail */
+        LJIT_EMIT(a, 0x48, 0x83, 0xf9, 0xff, 0x75, 19); /* cmp rcx, -1; jne +19 */
+        LJIT_EMIT(a, 0x48, 0xba);                      /* mov rdx, LONG_MIN */
+        ljit_imm64(a, LONG_MIN);
+        LJIT_EMIT(a, 0x48, 0x39, 0xd0);                /* cmp rax, rdx */
+        ljit_fail(a, 0x84);                            /* je fail */
+        LJIT_EMIT(a, 0x48, 0x99, 0x48, 0xf7, 0xf9);    /* cqo; idiv rcx */
+        if (c->op == LARITH_MOD) {
+          LJIT_EMIT(a, 0x48, 0x89, 0xd0);              /* mov rax, rdx */
+        }
+      break;
+      case LARITH_POW: {
+        LJIT_EMIT(a, 0x48, 0x89, 0xc7, 0x48, 0x89, 0xce); /* rdi = x; rsi = y */
+        LJIT_EMIT(a, 0x4c, 0x89, 0xea);                /* rdx = fail */
+        
+        /* Keep the stack 16-byte aligned across the call */
+        int pad = a->depth % 2;
+        if (pad) { LJIT_EMIT(a, 0x48, 0x83, 0xec, 0x08); }
+        LJIT_EMIT(a, 0x48, 0xb8);                      /* mov rax, ljit_pow */
+        ljit_imm64(a, (long)ljit_pow);
+        LJIT_EMIT(a, 0xff, 0xd0);                      /* call rax */
+        if (pad) { LJIT_EMIT(a, 0x48, 0x83, 0xc4, 0x08); }
+        LJIT_EMIT(a, 0x41, 0x83, 0x7d, 0x00, 0x00);    /* cmp dword [r13], 0 */
+        ljit_fail(a, 0x85);                            /* jne fail */
+      }
+      break;
+    }
+    
+    LJIT_EMIT(a, 0x50);                                /* push rax */
+    a->depth++;
+  }
+  
+  return 1;
+}
+
+/* Records a nested node whose head the code assumes, to be checked */
+/* before each run                                                  */
+void ljit_head(ljit_asm* a, lclo* c) {
+  if (a->head_count == a->head_cap) {
+    a->head_cap = a->head_cap ? a->head_cap * 2 : 8;
+    a->heads = realloc(a->heads, sizeof(lclo*) * a->head_cap);
+  }
+  a->heads[a->head_count++] = c;
+}
+
+/* Emits code leaving the value of c on the stack, or returns 0 if */
+/* c is not something the compiler handles                         */
+int ljit_expr(ljit_asm* a, lenv* e, lclo* c) {
+  
+  int constant = (c->fn == lclo_const && lval_type(c->val) == LVAL_NUM)
+    || (c->fn == lclo_folded && lclo_refold(e, c));
+  if (constant) {
+    if (c->fn == lclo_folded) { ljit_head(a, c); }
+    LJIT_EMIT(a, 0x48, 0xb8);                          /* mov rax, imm64 */
+    ljit_imm64(a, lval_as_num(c->val));
+    LJIT_EMIT(a, 0x50);
+    a->depth++;
+    return 1;
+  }
+  
+  if (c->fn == lclo_load) {
+    if (a->sym_count == LJIT_MAX_SYMS) { return 0; }
+    int disp = a->sym_count * 8;
+    a->syms[a->sym_count++] = c->val;
+    LJIT_EMIT(a, 0x49, 0x8b, 0x84, 0x24);              /* mov rax, [r12 + disp32] */
+    ljit_bytes(a, &disp, 4);
+    LJIT_EMIT(a, 0x50);
+    a->depth++;
+    return 1;
+  }
+  
+  if (c->fn == lclo_arith && lclo_resolved(e, c)) {
+    ljit_head(a, c);
+    return ljit_arith(a, e, c);
+  }
+  
+  return 0;
+}
+
+void ljit_del(ljit* j) {
+  munmap(j->mem, j->size);
+  free(j->syms);
+  free(j->heads);
+  free(j);
+}
+
+/* Compiles an arithmetic closure, or returns NULL */
+ljit* ljit_compile(lenv* e, lclo* c) {
+  
+  ljit_asm a = { 0 };
+  a.syms = malloc(sizeof(lval*) * LJIT_MAX_SYMS);
+  
+  /* long fn(long* in, int* fail), with the inputs kept in r12 and */
+  /* the failure flag in r13. rbx holds the stack to unwind to.    */
+  LJIT_EMIT(&a, 0x53, 0x41, 0x54, 0x41, 0x55);         /* push rbx; push r12; push r13 */
+  LJIT_EMIT(&a, 0x48, 0x89, 0xe3);                     /* mov rbx, rsp */
+  LJIT_EMIT(&a, 0x49, 0x89, 0xfc, 0x49, 0x89, 0xf5);   /* mov r12, rdi; mov r13, rsi */
+  
+  int ok = ljit_arith(&a, e, c);
+  
+  LJIT_EMIT(&a, 0x58);                                 /* pop rax */
+  LJIT_EMIT(&a, 0x41, 0x5d, 0x41, 0x5c, 0x5b, 0xc3);   /* pop r13; pop r12; pop rbx; ret */
+  
+  /* Bail out: unwind, set *fail and return */
+  int fail = a.count;
+  LJIT_EMIT(&a, 0x48, 0x89, 0xdc);                     /* mov rsp, rbx */
+  LJIT_EMIT(&a, 0x41, 0xc7, 0x45, 0x00, 0x01, 0x00, 0x00, 0x00); /* mov dword [r13], 1 */
+  LJIT_EMIT(&a, 0x41, 0x5d, 0x41, 0x5c, 0x5b, 0xc3);
+  
+  for (int i = 0; i < a.fail_count; i++) {
+    int rel = fail - (a.fails[i] + 4);
+    memcpy(a.buf + a.fails[i], &rel, 4);
+  }
+  free(a.fails);
+  
+  if (!ok) {
+    free(a.buf);
+    free(a.syms);
+    free(a.heads);
+    return NULL;
+  }
+  
+  /* Copy into fresh pages, then make them executable but not writable */
+  size_t size = (a.count + 4095) & ~(size_t)4095;
+  void* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED) {
+    free(a.buf);
+    free(a.syms);
+    free(a.heads);
+    return NULL;
+  }
+  memcpy(mem, a.buf, a.count);
+  mprotect(mem, size, PROT_READ | PROT_EXEC);
+  free(a.buf);
+  
+  ljit* j = malloc(sizeof(ljit));
+  j->fn = (ljitfn)mem;
+  j->mem = mem;
+  j->size = size;
+  j->syms = a.syms;
+  j->sym_count = a.sym_count;
+  j->heads = a.heads;
+  j->head_count = a.head_count;
+  return j;
+}
+
+/* Runs compiled code, or returns NULL if a guard failed */
+lval* ljit_run(lenv* e, ljit* j) {
+  
+  for (int i = 0; i < j->head_count; i++) {
+    lclo* c = j->heads[i];
+    int ok = c->fn == lclo_folded ? lclo_refold(e, c) : lclo_resolved(e, c);
+    if (!ok) { return NULL; }
+  }
+  
+  long in[LJIT_MAX_SYMS];
+  for (int i = 0; i < j->sym_count; i++) {
+    lval* x = lenv_load(e, j->syms[i]);
+    if (!x || lval_type(x) != LVAL_NUM) { return NULL; }
+    in[i] = lval_as_num(x);
+  }
+  
+  int fail = 0;
+  long x = j->fn(in, &fail);
+  return fail ? NULL : lval_num(x);
+}
+
+#endif
+
+/* Code Cache */
+
+/* Compiled forms of shared Q-Expressions passed to eval, in an */
+/* open-addressing table keyed by node. Each backend fills in   */
+/* its own form on first use.                                   */
+
+struct {
+  lval** keys;
+  lcode** codes;
+  lclo** clos;
+  long* hits;
+  int count;
+  int cap;
+} lcache = { NULL, NULL, NULL, NULL, 0, 0 };
+
+int lcache_find(lval* v) {
+  int mask = lcache.cap - 1;
+  int i = lptr_hash(v) & mask;
+  while (lcache.keys[i] && lcache.keys[i] != v) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+/* Returns the slot for v, adding an empty entry if it has none */
+int lcache_slot(lval* v) {
+  
+  if (v->flags & LVAL_COMPILED) { return lcache_find(v); }
+  
+  if ((lcache.count + 1) * 2 > lcache.cap) {
+    lval** keys = lcache.keys;
+    lcode** codes = lcache.codes;
+    lclo** clos = lcache.clos;
+    long* hits = lcache.hits;
+    int cap = lcache.cap;
+    lcache.cap = cap ? cap * 2 : 64;
+    lcache.keys = calloc(lcache.cap, sizeof(lval*));
+    lcache.codes = calloc(lcache.cap, sizeof(lcode*));
+    lcache.clos = calloc(lcache.cap, sizeof(lclo*));
+    lcache.hits = calloc(lcache.cap, sizeof(long));
+    for (int i = 0; i < cap; i++) {
+      if (!keys[i]) { continue; }
+      int j = lcache_find(keys[i]);
+      lcache.keys[j] = keys[i];
+      lcache.codes[j] = codes[i];
+      lcache.clos[j] = clos[i];
+      lcache.hits[j] = hits[i];
+    }
+    free(keys);
+    free(codes);
+    free(clos);
+    free(hits);
+  }
+  
+  int i = lcache_find(v);
+  lcache.keys[i] = v;
+  lcache.count++;
+  v->flags |= LVAL_COMPILED;
+  return i;
+}
+
+void lcode_forget(lval* v) {
+  
+  v->flags &= ~LVAL_COMPILED;
+  
+  int mask = lcache.cap - 1;
+  int i = lcache_find(v);
+  if (lcache.codes[i]) { lcode_del(lcache.codes[i]); }
+  if (lcache.clos[i]) { lclo_del(lcache.clos[i]); }
+  lcache.count--;
+  
+  /* Backward-shift deletion, so no later entry loses its way home */
+  int j = i;
+  while (1) {
+    lcache.keys[i] = NULL;
+    lcache.codes[i] = NULL;
+    lcache.clos[i] = NULL;
+    lcache.hits[i] = 0;
+    while (1) {
+      j = (j + 1) & mask;
+      if (!lcache.keys[j]) { return; }
+      int home = lptr_hash(lcache.keys[j]) & mask;
+      if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) { break; }
+    }
+    lcache.keys[i] = lcache.keys[j];
+    lcache.codes[i] = lcache.codes[j];
+    lcache.clos[i] = lcache.clos[j];
+    lcache.hits[i] = lcache.hits[j];
+    i = j;
+  }
+}
+
+/* Returns cached code for a Q-Expression that will be run again, */
+/* or NULL if it should just be evaluated directly                */
+lcode* lcode_cached(lval* v) {
+  
+  /* The cache is keyed by node, and a minor collection moves young */
+  /* nodes without taking their entries along, so they are not kept */
+  if (lval_in_nursery(v)) { return NULL; }
+  
+  if (v->flags & LVAL_COMPILED) {
+    lcode* c = lcache.codes[lcache_find(v)];
+    if (c) { return c; }
+  }
+  
+  lcode* c = lcode_compile(v);
+  if (c->young) {
+    lcode_del(c);
+    return NULL;
+  }
+  int i = lcache_slot(v);
+  lcache.codes[i] = c;
+  return c;
+}
+
+/* As lcode_cached, for the closure backend */
+lclo* lclo_cached(lenv* e, lval* v) {
+  
+  if (lval_in_nursery(v)) { return NULL; }
+  
+  if (v->flags & LVAL_COMPILED) {
+    lclo* c = lcache.clos[lcache_find(v)];
+    if (c) { return c; }
+  }
+  
+  int young = 0;
+  lclo* c = lclo_compile(e, v, &young);
+  if (young) {
+    lclo_del(c);
+    return NULL;
+  }
+  int i = lcache_slot(v);
+  lcache.clos[i] = c;
+  return c;
+}
+
+/* Tiers */
+
+/* Counts a run of a form passed to eval, and returns its closure once */
+/* it has run ltier.threshold times or NULL to walk the tree instead   */
+lclo* ltier_closure(lenv* e, lval* v) {
+  
+  /* The cache is keyed by node, and a minor collection moves nodes */
+  /* out of the nursery, so a young form is not counted until then  */
+  if (lval_in_nursery(v)) {
+    ltier.cold++;
+    return NULL;
+  }
+  
+  int i = lcache_slot(v);
+  lcache.hits[i]++;
+  if (!lcache.clos[i] && lcache.hits[i] >= ltier.threshold) {
+    if (lclo_cached(e, v)) { ltier.promotions++; }
+    i = lcache_find(v);
+  }
+  
+  lclo* c = lcache.clos[i];
+  if (c) { ltier.warm++; } else { ltier.cold++; }
+  return c;
+}
+
+lval* lval_read(mpc_ast_t* t);
+
+/* Lines entered at the prompt while tiered are counted in a small   */
+/* table by a hash of their text, a line taking the entry of any     */
+/* other that hashes to the same place. Only a line that has run     */
+/* ltier.threshold times is read into a form, kept as first read,    */
+/* before folding, as a Q-Expression. It is compiled to a closure    */
+/* once a minor collection has moved it out of the nursery.          */
+#define LTIER_LINES 256
+
+typedef struct {
+  unsigned long hash;
+  char* text;
+  long hits;
+  lval* form;
+} ltier_entry;
+
+ltier_entry ltier_lines[LTIER_LINES];
+
+void ltier_line_clear(ltier_entry* l) {
+  free(l->text);
+  if (l->form) { lval_del(l->form); }
+  l->text = NULL;
+  l->form = NULL;
+  l->hits = 0;
+}
+
+void ltier_lines_del(void) {
+  for (int i = 0; i < LTIER_LINES; i++) { ltier_line_clear(&ltier_lines[i]); }
+}
+
+void ltier_lines_mark(void) {
+  for (int i = 0; i < LTIER_LINES; i++) {
+    if (ltier_lines[i].form) { lgc_mark(ltier_lines[i].form); }
+  }
+}
+
+void ltier_lines_evacuate(int* n) {
+  for (int i = 0; i < LTIER_LINES; i++) {
+    ltier_lines[i].form = lgc_evacuate(ltier_lines[i].form, n);
+  }
+}
+
+/* Counts a run of a line, and returns its closure once it is hot */
+/* or NULL to read and walk it instead                            */
+lclo* ltier_line(lenv* e, mpc_ast_t* t, char* line) {
+  
+  unsigned long h = lsym_hash(line);
+  ltier_entry* l = &ltier_lines[h & (LTIER_LINES - 1)];
+  
+  if (!l->text || l->hash != h || strcmp(l->text, line) != 0) {
+    ltier_line_clear(l);
+    l->hash = h;
+    l->text = malloc(strlen(line) + 1);
+    strcpy(l->text, line);
+  }
+  l->hits++;
+  
+  lclo* c = NULL;
+  if (l->form) {
+    int fresh = !(l->form->flags & LVAL_COMPILED);
+    c = lclo_cached(e, l->form);
+    if (c && fresh) { ltier.promotions++; }
+  } else if (l->hits >= ltier.threshold) {
+    lval* v = lval_read(t);
+    l->form = lval_list(LVAL_QEXPR, v->cell, v->count);
+    lval_del(v);
+  }
+  
+  if (c) { ltier.warm++; } else { ltier.cold++; }
+  return c;
+}
 
-lval* builtin_list(lenv* e, lval* a) {
-  a->type = LVAL_QEXPR;
-  return a;
+void ltier_print_stats(void) {
+  printf("tier     runs\n");
+  printf("tree     %ld\n", ltier.cold);
+  printf("closure  %ld\n", ltier.warm);
+  printf("native   %ld\n", ltier.native);
+  printf("promoted %ld to closures, %ld to native code, at %ld runs\n",
+    ltier.promotions, ltier.compiles, ltier.threshold);
+  
+  for (int i = 0; i < lcache.cap; i++) {
+    if (!lcache.keys[i] || !lcache.hits[i]) { continue; }
+    lclo* c = lcache.clos[i];
+    printf("%8ld %-8s ", lcache.hits[i],
+      !c ? "tree" : c->jit ? "native" : "closure");
+    lval_println(lcache.keys[i]);
+  }
+  for (int i = 0; i < LTIER_LINES; i++) {
+    ltier_entry* l = &ltier_lines[i];
+    if (!l->text) { continue; }
+    lclo* c = l->form && (l->form->flags & LVAL_COMPILED)
+      ? lcache.clos[lcache_find(l->form)] : NULL;
+    printf("%8ld %-8s %s\n", l->hits,
+      !c ? "tree" : c->jit ? "native" : "closure", l->text);
+  }
 }
 
-lval* builtin_head(lenv* e, lval* a) {
-  LASSERT_NUM("head", a, 1);
-  LASSERT_TYPE("head", a, 0, LVAL_QEXPR);
-  LASSERT_NOT_EMPTY("head", a, 0);
+lval* lval_fold(lenv* e, lval* v);
+lval* lval_resolve(lenv* e, lval* v);
+
+/* Reads and evaluates a line entered at the prompt with the selected */
+/* backend. Tiered, a line entered often enough runs from a closure   */
+/* compiled from it as first read; otherwise each line is folded and  */
+/* resolved afresh before it runs.                                    */
+lval* lval_eval_top(lenv* e, mpc_ast_t* t, char* line) {
   
-  lval* v = lval_take(a, 0);  
-  while (v->count > 1) { lval_del(lval_pop(v, 1)); }
-  return v;
+  if (lbackend == LBACKEND_TIERED) {
+    lclo* c = ltier_line(e, t, line);
+    if (c) { return lclo_run(e, c, 0); }
+  }
+  
+  lval* v = lval_resolve(e, lval_fold(e, lval_read(t)));
+  switch (lbackend) {
+    case LBACKEND_CLOSURE: return lclo_eval(e, v);
+    case LBACKEND_VM: return lvm_eval(e, v);
+    default: return lval_eval(e, v);
+  }
 }
 
-lval* builtin_tail(lenv* e, lval* a) {
-  LASSERT_NUM("tail", a, 1);
-  LASSERT_TYPE("tail", a, 0, LVAL_QEXPR);
-  LASSERT_NOT_EMPTY("tail", a, 0);
+/* Reading */
+
+/* The parser, and the passes between it and evaluation, recurse once */
+/* per level of nesting, so a line nested deeper than this is refused */
+/* before it is parsed rather than left to overflow the C stack.      */
+#define LREAD_DEPTH 1024
 
-  lval* v = lval_take(a, 0);  
-  lval_del(lval_pop(v, 0));
-  return v;
+int lread_too_deep(char* s) {
+  int depth = 0;
+  for (; *s; s++) {
+    if (*s == '(' || *s == '{') {
+      if (++depth > LREAD_DEPTH) { return 1; }
+    }
+    if (*s == ')' || *s == '}') { depth--; }
+  }
+  return 0;
 }
 
-lval* builtin_eval(lenv* e, lval* a) {
-  LASSERT_NUM("eval", a, 1);
-  LASSERT_TYPE("eval", a, 0, LVAL_QEXPR);
-  
-  lval* x = lval_take(a, 0);
-  x->type = LVAL_SEXPR;
-  return lval_eval(e, x);
+lval* lval_read_num(mpc_ast_t* t) {
+  errno = 0;
+  long x = strtol(t->contents, NULL, 10);
+  return errno != ERANGE ? lval_num(x) : lbig_read(t->contents);
 }
 
-lval* builtin_join(lenv* e, lval* a) {
+lval* lval_read(mpc_ast_t* t) {
   
-  for (int i = 0; i < a->count; i++) {
-    LASSERT_TYPE("join", a, i, LVAL_QEXPR);
-  }
+  if (strstr(t->tag, "number")) { return lval_read_num(t); }
+  if (strstr(t->tag, "symbol")) { return lval_sym(t->contents); }
   
-  lval* x = lval_pop(a, 0);
+  lval* x = NULL;
+  if (strcmp(t->tag, ">") == 0) { x = lval_sexpr(); } 
+  if (strstr(t->tag, "sexpr"))  { x = lval_sexpr(); }
+  if (strstr(t->tag, "qexpr"))  { x = lval_qexpr(); }
   
-  while (a->count) {
-    lval* y = lval_pop(a, 0);
-    x = lval_join(x, y);
+  for (int i = 0; i < t->children_num; i++) {
+    if (strcmp(t->children[i]->contents, "(") == 0) { continue; }
+    if (strcmp(t->children[i]->contents, ")") == 0) { continue; }
+    if (strcmp(t->children[i]->contents, "}") == 0) { continue; }
+    if (strcmp(t->children[i]->contents, "{") == 0) { continue; }
+    if (strcmp(t->children[i]->tag,  "regex") == 0) { continue; }
+    x = lval_add(x, lval_read(t->children[i]));
   }
   
-  lval_del(a);
   return x;
 }
 
-long exponential(long x, long y) {
-  if(y == 0) {
-      return 1;
-  }
-  else if(y==1) {
-    return x;
-  }
-  else if(y%2 == 0) {
-    return exponential(x*x,y/2);
-  }
-  else if(y%2 == 1) {
-    return x*exponential(x*x, y/2);
+/* Folding */
+
+/* Before a line is evaluated, calls to the arithmetic builtins in it  */
+/* are simplified where that cannot change the result. Constant        */
+/* arguments are folded, nested calls to the same associative operator */
+/* are flattened, and identity operands are dropped. Q-Expressions are  */
+/* data and are left alone. Only closures, see lclo_fold, fold one      */
+/* passed to eval, as they compile it; the tree walker and the bytecode */
+/* run it unfolded every time.                                          */
+/*                                                                      */
+/* A head symbol only counts as the builtin it names now while no call  */
+/* that might rebind it, such as def, has run before it in evaluation   */
+/* order. A rewrite that would move an argument which might not be a    */
+/* number is skipped, so type errors still name the same argument.      */
+
+typedef struct {
+  lenv* env;
+  int dirty;
+} lfold;
+
+/* Returns the operator of a call to an arithmetic builtin, or -1 */
+int lfold_op(lfold* f, lval* v) {
+  if (f->dirty || lval_type(v) != LVAL_SEXPR || v->count < 2) { return -1; }
+  if (lval_type(v->cell[0]) != LVAL_SYM) { return -1; }
+  
+  lenv* e = f->env;
+  lval* x = lenv_peek(e, v->cell[0]->sym);
+  if (!x || lval_type(x) != LVAL_FUN) { return -1; }
+  return larith_op(x->fun);
+}
+
+/* Checks the cells of v from i on evaluate to numbers or errors */
+int lfold_settled(lfold* f, lval* v, int i) {
+  for (; i < v->count; i++) {
+    lval* x = v->cell[i];
+    if (lval_type(x) != LVAL_NUM && lval_type(x) != LVAL_ERR && lfold_op(f, x) < 0) {
+      return 0;
+    }
   }
+  return 1;
+}
+
+/* Moves a cell out of a list that is about to be deleted */
+lval* lfold_move(lval* v, int i) {
+  lval* x = v->cell[i];
+  v->cell[i] = NULL;
+  return x;
 }
 
-lval* builtin_op(lenv* e, lval* a, char* op) {
+lval* lfold_call(lfold* f, lval* v, int op) {
   
-  for (int i = 0; i < a->count; i++) {
-    LASSERT_TYPE(op, a, i, LVAL_NUM);
+  /* Splice in the arguments of nested calls to the same operator */
+  int assoc = op == LARITH_ADD || op == LARITH_MUL || op == LARITH_AND
+    || op == LARITH_OR || op == LARITH_MIN || op == LARITH_MAX;
+  if (assoc) {
+    lval* w = lval_sexpr();
+    for (int i = 0; i < v->count; i++) {
+      lval* x = v->cell[i];
+      if (i > 0 && lfold_op(f, x) == op
+          && lfold_settled(f, x, 1) && lfold_settled(f, v, i + 1)) {
+        for (int j = 1; j < x->count; j++) {
+          w = lval_add(w, lfold_move(x, j));
+        }
+      } else {
+        w = lval_add(w, lfold_move(v, i));
+      }
+    }
+    lval_del(v);
+    v = w;
   }
   
-  lval* x = lval_pop(a, 0);
+  /* Fold the leading run of constant arguments */
+  int k = 0;
+  while (1 + k < v->count && lval_type(v->cell[1 + k]) == LVAL_NUM) { k++; }
+  int all = 1 + k == v->count;
+  if ((k >= 2 || (all && k == 1)) && lfold_settled(f, v, 1 + k)
+      && larith_safe(op, &v->cell[1], k)) {
+    lval* x = larith_fold(op, &v->cell[1], k);
+    if (all) {
+      lval_del(v);
+      return x;
+    }
+    lval* w = lval_add(lval_sexpr(), lfold_move(v, 0));
+    w = lval_add(w, x);
+    for (int i = 1 + k; i < v->count; i++) {
+      w = lval_add(w, lfold_move(v, i));
+    }
+    lval_del(v);
+    v = w;
+  }
   
-  if ((strcmp(op, "-") == 0) && a->count == 0) {
-    x->num = -x->num;
+  /* Drop identity operands. The first argument of - and / is not one, */
+  /* and - keeps two arguments as with one it negates instead.         */
+  long id;
+  int has_id = 1;
+  switch (op) {
+    case LARITH_ADD: case LARITH_SUB: case LARITH_OR: id = 0; break;
+    case LARITH_MUL: case LARITH_DIV: id = 1; break;
+    case LARITH_AND: id = -1; break;
+    default: has_id = 0; break;
+  }
+  int first = (op == LARITH_SUB || op == LARITH_DIV) ? 2 : 1;
+  int least = op == LARITH_SUB ? 2 : 1;
+  for (int i = v->count - 1; has_id && i >= first; i--) {
+    lval* x = v->cell[i];
+    if (lval_type(x) != LVAL_NUM || lval_as_num(x) != id) { continue; }
+    if (v->count - 2 < least || !lfold_settled(f, v, i + 1)) { continue; }
+    lval_del(lval_pop(v, i));
   }
   
-  while (a->count > 0) {  
-    lval* y = lval_pop(a, 0);
-    
-    if (strcmp(op, "+") == 0) { x->num += y->num; }
-    if (strcmp(op, "-") == 0) { x->num -= y->num; }
-    if (strcmp(op, "*") == 0) { x->num *= y->num; }
-    if (strcmp(op, "/") == 0) {
-      if (y->num == 0) {
-        lval_del(x); lval_del(y);
-        x = lval_err("Division By Zero.");
-        break;
-      }
-      x->num /= y->num;
-    }
-    else if (strcmp(op, "%") == 0) { x->num %= y->num; }
-    else if (strcmp(op, "&") == 0) { x->num &= y->num; }
-    else if (strcmp(op, "|") == 0) { x->num |= y->num; }
-    else if (strcmp(op, "**") == 0) { 
-      x->num += exponential(x->num, y->num); 
-    }
-    else if (strcmp(op, "min") == 0) {
-        if(y->num < x->num) {
-          x->num = y->num;
-        }
-    }
-    else if (strcmp(op, "max") == 0) {
-        if(y->num > x->num) {
-            x->num = y->num;    
-        }
-    }
-    lval_del(y);
+  /* A lone argument that is already a number is the result */
+  if (v->count == 2 && op != LARITH_SUB && lfold_settled(f, v, 1)) {
+    lval* x = lfold_move(v, 1);
+    lval_del(v);
+    return x;
   }
   
-  lval_del(a);
-  return x;
+  return v;
 }
 
-lval* builtin_add(lenv* e, lval* a) {
-  return builtin_op(e, a, "+");
+lval* lfold_expr(lfold* f, lval* v) {
+  if (lval_type(v) != LVAL_SEXPR) { return v; }
+  
+  for (int i = 0; i < v->count; i++) {
+    v->cell[i] = lfold_expr(f, v->cell[i]);
+    lgc_barrier(v, v->cell[i]);
+  }
+  
+  int op = lfold_op(f, v);
+  if (op < 0) {
+    
+    /* Any other call might rebind something later calls rely on. */
+    /* A special form is no call, and its cells were seen above.   */
+    if (v->count >= 2 && lform_find(v) < 0) { f->dirty = 1; }
+    return v;
+  }
+  return lfold_call(f, v, op);
 }
 
-lval* builtin_sub(lenv* e, lval* a) {
-  return builtin_op(e, a, "-");
+lval* lfold_line(lfold* f, lval* v) {
+  v = lfold_expr(f, v);
+  
+  /* The line itself has to stay an S-Expression */
+  if (lval_type(v) != LVAL_SEXPR) { v = lval_add(lval_sexpr(), v); }
+  return v;
 }
 
-lval* builtin_mul(lenv* e, lval* a) {
-  return builtin_op(e, a, "*");
+/* Simplifies a line read at the prompt before it is evaluated in e */
+lval* lval_fold(lenv* e, lval* v) {
+  lfold f = { e, 0 };
+  return lfold_line(&f, v);
 }
 
-lval* builtin_div(lenv* e, lval* a) {
-  return builtin_op(e, a, "/");
-}
+/* Resolution */
 
-lval* builtin_and(lenv* e, lval* a) {
-  return builtin_op(e, a, "&");
-}
+/* Each symbol that is evaluated as code is given an address before it */
+/* runs: how many frames out from where it is evaluated its binding    */
+/* lives, and its slot there, so loading it is an array load rather    */
+/* than a name lookup (see lenv_load). At the prompt every name is     */
+/* global. A lambda's body is addressed when the lambda is made,       */
+/* against its parameters and the frames it was made in, which are     */
+/* the frames it will run under. Q-Expressions are data that may be    */
+/* evaluated anywhere, so their symbols are looked up by name. Only    */
+/* def gives a name a global slot, so a global not yet defined keeps   */
+/* an unknown slot until it is.                                        */
 
-lval* builtin_or(lenv* e, lval* a) {
-  return builtin_op(e, a, "|");
+void lval_resolve_in(lenv* e, lval* v) {
+  switch (lval_type(v)) {
+    case LVAL_SYM:
+      v->depth = 0;
+      v->slot = lenv_slot(e, v->sym);
+    break;
+    case LVAL_SEXPR:
+      for (int i = 0; i < v->count; i++) {
+        lval_resolve_in(e, v->cell[i]);
+      }
+    break;
+  }
 }
 
-lval* builtin_mod(lenv* e, lval* a) {
-  return builtin_op(e, a, "%");
+lval* lval_resolve(lenv* e, lval* v) {
+  lval_resolve_in(e, v);
+  return v;
 }
 
-lval* builtin_pow(lenv* e, lval* a) {
-  return builtin_op(e, a, "**");
+/* Gives symbol k, in the body of a lambda with formals made in e, its */
+/* address: the first parameter of that name, or else the innermost   */
+/* frame out from e binding it, or else the top-level environment.    */
+void lval_address_sym(lenv* e, lval* formals, lval* k) {
+  
+  for (int i = 0; i < formals->count; i++) {
+    if (formals->cell[i]->sym == k->sym) {
+      k->depth = 0;
+      k->slot = i;
+      return;
+    }
+  }
+  
+  k->depth = 1;
+  for (; e->par; e = e->par, k->depth++) {
+    int s = lenv_slot(e, k->sym);
+    if (s >= 0) {
+      k->slot = s;
+      return;
+    }
+  }
+  k->slot = lenv_slot(e, k->sym);
 }
 
-lval* builtin_min(lenv* e, lval* a) {
-  return builtin_op(e, a, "min");
+/* Returns a copy of v, part of the body of a lambda with formals made */
+/* in e, with each symbol it evaluates addressed. Anything else is     */
+/* shared as it is.                                                    */
+lval* lval_address_expr(lenv* e, lval* formals, lval* v) {
+  switch (lval_type(v)) {
+    case LVAL_SYM: {
+      lval* k = lval_copy(v);
+      lval_address_sym(e, formals, k);
+      return k;
+    }
+    case LVAL_SEXPR: {
+      lval* x = lval_sexpr();
+      for (int i = 0; i < v->count; i++) {
+        x = lval_add(x, lval_address_expr(e, formals, v->cell[i]));
+      }
+      return x;
+    }
+    default: return lval_ref(v);
+  }
 }
 
-lval* builtin_max(lenv* e, lval* a) {
-  return builtin_op(e, a, "max");
+/* Returns a copy of the body of a lambda with formals made in e, with */
+/* each symbol it evaluates addressed. The copy belongs to the lambda  */
+/* and is only ever evaluated in its frames, where the addresses hold. */
+lval* lval_address(lenv* e, lval* formals, lval* body) {
+  lval* x = lval_qexpr();
+  for (int i = 0; i < body->count; i++) {
+    x = lval_add(x, lval_address_expr(e, formals, body->cell[i]));
+  }
+  return x;
 }
 
-lval* builtin_def(lenv* e, lval* a) {
+/* Compiling to C */
 
-  LASSERT_TYPE("def", a, 0, LVAL_QEXPR);
-  
-  /* First argument is symbol list */
-  lval* syms = a->cell[0];
-  
-  /* Ensure all elements of first list are symbols */
-  for (int i = 0; i < syms->count; i++) {
-    LASSERT(a, (syms->cell[i]->type == LVAL_SYM),
-      "Function 'def' cannot define non-symbol. "
-      "Got %s, Expected %s.",
-      ltype_name(syms->cell[i]->type), ltype_name(LVAL_SYM));
+/* vhisp -c file reads a script and prints a C translation unit that    */
+/* runs it, to be built along with this file compiled with              */
+/* -DVHISP_NO_MAIN. Each line of the script runs as if typed at the     */
+/* prompt and its result is printed, but nothing is parsed or walked:   */
+/* literals become constructor calls, and every S-Expression becomes    */
+/* straight-line pushes onto the root stack followed by lvm_call.       */
+/* A special form becomes C control flow around the pushes of its       */
+/* cells, so a branch not taken is never built. Blank lines are skipped. */
+/*                                                                      */
+/* Lambda bodies are still Q-Expressions, built as lists and run by the */
+/* evaluator when called, and each line is compiled on its own: any    */
+/* line may redefine what later ones call, so nothing is assumed about  */
+/* names across lines.                                                  */
+
+typedef struct {
+  FILE* out;
+  char** syms;
+  int sym_count;
+  int sym_cap;
+} laot;
+
+/* Returns the index of an interned symbol in the generated table */
+int laot_sym(laot* a, char* sym) {
+  for (int i = 0; i < a->sym_count; i++) {
+    if (a->syms[i] == sym) { return i; }
   }
-  
-  /* Check correct number of symbols and values */
-  LASSERT(a, (syms->count == a->count-1),
-    "Function 'def' passed too many arguments for symbols. "
-    "Got %i, Expected %i.",
-    syms->count, a->count-1);
-  
-  /* Assign copies of values to symbols */
-  for (int i = 0; i < syms->count; i++) {
-    lenv_put(e, syms->cell[i], a->cell[i+1]);
+  if (a->sym_count == a->sym_cap) {
+    a->sym_cap = a->sym_cap ? a->sym_cap * 2 : 16;
+    a->syms = realloc(a->syms, sizeof(char*) * a->sym_cap);
   }
-  
-  lval_del(a);
-  return lval_sexpr();
+  a->syms[a->sym_count] = sym;
+  return a->sym_count++;
 }
 
-void lenv_add_builtin(lenv* e, char* name, lbuiltin func) {
-  lval* k = lval_sym(name);
-  lval* v = lval_fun(func);
-  lenv_put(e, k, v);
-  lval_del(k); lval_del(v);
+void laot_string(laot* a, char* s) {
+  fputc('"', a->out);
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\') { fputc('\\', a->out); }
+    fputc(*s, a->out);
+  }
+  fputc('"', a->out);
 }
 
-void lenv_add_builtins(lenv* e) {
-  /* Variable Functions */
-  lenv_add_builtin(e, "def", builtin_def);
-  
-  /* List Functions */
-  lenv_add_builtin(e, "list", builtin_list);
-  lenv_add_builtin(e, "head", builtin_head);
-  lenv_add_builtin(e, "tail", builtin_tail);
-  lenv_add_builtin(e, "eval", builtin_eval);
-  lenv_add_builtin(e, "join", builtin_join);
+/* Emits an expression for a number, error or symbol literal */
+void laot_atom(laot* a, lval* v) {
+  switch (lval_type(v)) {
+    case LVAL_NUM:
+      if (lval_as_num(v) == LONG_MIN) {
+        fprintf(a->out, "lval_num(-%ldL - 1)", LONG_MAX);
+      } else {
+        fprintf(a->out, "lval_num(%ldL)", lval_as_num(v));
+      }
+    break;
+    case LVAL_BIG: {
+      char* s = lbig_string(v);
+      fprintf(a->out, "lbig_read(\"%s\")", s);
+      free(s);
+    }
+    break;
+    case LVAL_ERR:
+      fprintf(a->out, "lval_err(\"%%s\", ");
+      laot_string(a, v->err);
+      fprintf(a->out, ")");
+    break;
+    case LVAL_SYM:
+      fprintf(a->out, "lval_sym(lsym_table[%d])", laot_sym(a, v->sym));
+    break;
+  }
+}
+
+/* Emits statements, indented by n, that build a fresh copy of the */
+/* list v in the local q<depth>. Nothing is collected while it is   */
+/* built, since allocation never reaches a safe point.              */
+void laot_list(laot* a, lval* v, int depth, int n) {
+  fprintf(a->out, "%*sq%d = %s;\n", n, "", depth,
+    lval_type(v) == LVAL_SEXPR ? "lval_sexpr()" : "lval_qexpr()");
   
-  /* Mathematical Functions */
-  lenv_add_builtin(e, "+", builtin_add);
-  lenv_add_builtin(e, "-", builtin_sub);
-  lenv_add_builtin(e, "*", builtin_mul);
-  lenv_add_builtin(e, "/", builtin_div);
-  lenv_add_builtin(e, "%", builtin_mod);
-  lenv_add_builtin(e, "&", builtin_and);
-  lenv_add_builtin(e, "|", builtin_or);
-  lenv_add_builtin(e, "**", builtin_pow);
-  lenv_add_builtin(e, ">", builtin_max);
-  lenv_add_builtin(e, "<", builtin_min);
-  
-  lenv_add_builtin(e, "add", builtin_add);
-  lenv_add_builtin(e, "sub", builtin_sub);
-  lenv_add_builtin(e, "mul", builtin_mul);
-  lenv_add_builtin(e, "div", builtin_div);
-  lenv_add_builtin(e, "mod", builtin_mod);
-  lenv_add_builtin(e, "and", builtin_and);
-  lenv_add_builtin(e, "or", builtin_or);
-  lenv_add_builtin(e, "pow", builtin_pow);
-  lenv_add_builtin(e, "max", builtin_max);
-  lenv_add_builtin(e, "min", builtin_min);
+  for (int i = 0; i < v->count; i++) {
+    lval* x = v->cell[i];
+    if (lval_type(x) == LVAL_SEXPR || lval_type(x) == LVAL_QEXPR) {
+      fprintf(a->out, "%*s{\n%*slval* q%d;\n", n, "", n + 2, "", depth + 1);
+      laot_list(a, x, depth + 1, n + 2);
+      fprintf(a->out, "%*sq%d = lval_add(q%d, q%d);\n%*s}\n",
+        n + 2, "", depth, depth, depth + 1, n, "");
+    } else {
+      fprintf(a->out, "%*sq%d = lval_add(q%d, ", n, "", depth, depth);
+      laot_atom(a, x);
+      fprintf(a->out, ");\n");
+    }
+  }
+}
 
-  /* Utility Functions */
+void laot_push(laot* a, lval* v, int n);
+
+/* Emits cells i on of the form k written as v, each indented by n and */
+/* pushed in turn, with the C control flow the form takes between them */
+void laot_form(laot* a, lval* v, int k, int i, int n) {
+  
+  int last = i + 1 == v->count;
+  switch (k) {
+    
+    case LFORM_IF:
+      laot_push(a, v->cell[1], n);
+      fprintf(a->out,
+        "%*s{\n%*sint t = laot_test(%d, 0);\n%*sif (t >= 0) {\n"
+        "%*slaot_drop();\n%*sif (t) {\n",
+        n, "", n + 2, "", k, n + 2, "", n + 4, "", n + 4, "");
+      laot_push(a, v->cell[2], n + 6);
+      fprintf(a->out, "%*s} else {\n", n + 4, "");
+      laot_push(a, v->cell[3], n + 6);
+      fprintf(a->out, "%*s}\n%*s}\n%*s}\n", n + 4, "", n + 2, "", n, "");
+    break;
+    
+    case LFORM_COND:
+      if (i == v->count) {
+        fprintf(a->out, "%*slgc_push(lval_sexpr());\n", n, "");
+        break;
+      }
+      laot_push(a, v->cell[i], n);
+      fprintf(a->out,
+        "%*s{\n%*sint t = laot_test(%d, %d);\n%*sif (t > 0) {\n"
+        "%*slaot_drop();\n",
+        n, "", n + 2, "", k, i - 1, n + 2, "", n + 4, "");
+      laot_push(a, v->cell[i + 1], n + 4);
+      fprintf(a->out, "%*s} else if (t == 0) {\n%*slaot_drop();\n",
+        n + 2, "", n + 4, "");
+      laot_form(a, v, k, i + 2, n + 4);
+      fprintf(a->out, "%*s}\n%*s}\n", n + 2, "", n, "");
+    break;
+    
+    case LFORM_WHEN:
+      if (i == 1) {
+        laot_push(a, v->cell[1], n);
+        fprintf(a->out,
+          "%*s{\n%*sint t = laot_test(%d, 0);\n%*sif (t >= 0) {\n"
+          "%*slaot_drop();\n",
+          n, "", n + 2, "", k, n + 2, "", n + 4, "");
+        if (last) {
+          fprintf(a->out, "%*slgc_push(lval_sexpr());\n", n + 4, "");
+        } else {
+          fprintf(a->out, "%*sif (t) {\n", n + 4, "");
+          laot_form(a, v, k, 2, n + 6);
+          fprintf(a->out, "%*s} else {\n%*slgc_push(lval_sexpr());\n%*s}\n",
+            n + 4, "", n + 6, "", n + 4, "");
+        }
+        fprintf(a->out, "%*s}\n%*s}\n", n + 2, "", n, "");
+        break;
+      }
+      
+      /* Each value but the last is dropped unless it is an error */
+      laot_push(a, v->cell[i], n);
+      if (last) { break; }
+      fprintf(a->out, "%*sif (!laot_failed()) {\n%*slaot_drop();\n",
+        n, "", n + 2, "");
+      laot_form(a, v, k, i + 1, n + 2);
+      fprintf(a->out, "%*s}\n", n, "");
+    break;
+    
+    case LFORM_AND:
+    case LFORM_OR:
+      if (v->count == 1) {
+        fprintf(a->out, "%*slgc_push(lval_num(%d));\n", n, "", k == LFORM_AND);
+        break;
+      }
+      laot_push(a, v->cell[i], n);
+      if (last) { break; }
+      
+      /* A value that decides the form is kept as its value */
+      fprintf(a->out, "%*sif (laot_test(%d, %d) == %d) {\n%*slaot_drop();\n",
+        n, "", k, i - 1, k == LFORM_AND, n + 2, "");
+      laot_form(a, v, k, i + 1, n + 2);
+      fprintf(a->out, "%*s}\n", n, "");
+    break;
+  }
 }
 
-/* Evaluation */
+/* Emits statements, indented by n, that push the value of v onto */
+/* the root stack                                                 */
+void laot_push(laot* a, lval* v, int n) {
+  switch (lval_type(v)) {
+    case LVAL_SYM:
+      fprintf(a->out, "%*slgc_push(lenv_lookup(e, lsym_table[%d]));\n",
+        n, "", laot_sym(a, v->sym));
+    break;
+    case LVAL_SEXPR: {
+      int k = lform_find(v);
+      if (k >= 0) {
+        lval* err = lform_check(k, v->count - 1);
+        if (err) {
+          fprintf(a->out, "%*slgc_push(", n, "");
+          laot_atom(a, err);
+          fprintf(a->out, ");\n");
+          lval_del(err);
+        } else {
+          laot_form(a, v, k, 1, n);
+        }
+        break;
+      }
+      for (int i = 0; i < v->count; i++) {
+        laot_push(a, v->cell[i], n);
+      }
+      fprintf(a->out, "%*slgc_push(lvm_call(e, %d));\n", n, "", v->count);
+    }
+    break;
+    case LVAL_QEXPR:
+      fprintf(a->out, "%*s{\n%*slval* q1;\n", n, "", n + 2, "");
+      laot_list(a, v, 1, n + 2);
+      fprintf(a->out, "%*slgc_push(q1);\n%*s}\n", n + 2, "", n, "");
+    break;
+    default:
+      fprintf(a->out, "%*slgc_push(", n, "");
+      laot_atom(a, v);
+      fprintf(a->out, ");\n");
+    break;
+  }
+}
 
-lval* lval_eval_sexpr(lenv* e, lval* v) {
+int laot_compile(char* path, mpc_parser_t* p) {
   
-  for (int i = 0; i < v->count; i++) {
-    v->cell[i] = lval_eval(e, v->cell[i]);
+  FILE* in = fopen(path, "r");
+  if (!in) {
+    fprintf(stderr, "Could not open '%s'.\n", path);
+    return 1;
   }
   
-  for (int i = 0; i < v->count; i++) {
-    if (v->cell[i]->type == LVAL_ERR) { return lval_take(v, i); }
+  laot a = { stdout, NULL, 0, 0 };
+  
+  /* Lines are folded against the builtins until the first call that */
+  /* might rebind one, after which nothing can be assumed            */
+  lenv* e = lenv_new();
+  lenv_add_builtins(e);
+  lfold f = { e, 0 };
+  fprintf(a.out,
+    "/* Generated by vhisp -c from %s. Build it with mpc.c and main.c, */\n"
+    "/* compiling main.c with -DVHISP_NO_MAIN.                           */\n"
+    "\n"
+    "#include <stdlib.h>\n"
+    "\n"
+    "typedef struct lval lval;\n"
+    "typedef struct lenv lenv;\n"
+    "\n"
+    "lval* lval_num(long x);\n"
+    "lval* lbig_read(char* s);\n"
+    "lval* lval_err(char* fmt, ...);\n"
+    "lval* lval_sym(char* s);\n"
+    "lval* lval_sexpr(void);\n"
+    "lval* lval_qexpr(void);\n"
+    "lval* lval_add(lval* v, lval* x);\n"
+    "char* lsym_intern(char* s);\n"
+    "lval* lenv_lookup(lenv* e, char* sym);\n"
+    "void lgc_push(lval* v);\n"
+    "lval* lvm_call(lenv* e, int n);\n"
+    "int laot_test(int k, int arg);\n"
+    "int laot_failed(void);\n"
+    "void laot_drop(void);\n"
+    "lval* laot_pop(void);\n"
+    "int vhisp_run(lval*(**lines)(lenv*), int count);\n"
+    "\n"
+    "static char** lsym_table;\n",
+    path);
+  
+  char* line = NULL;
+  size_t size = 0;
+  int count = 0;
+  int lineno = 0;
+  while (getline(&line, &size, in) != -1) {
+    lineno++;
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[strspn(line, " \t")] == '\0') { continue; }
+    
+    /* A line nested too deep compiles to the error it reads as */
+    if (lread_too_deep(line)) {
+      fprintf(a.out, "\nstatic lval* laot_line_%d(lenv* e) {\n", count++);
+      fprintf(a.out, "  return lval_err(\"Expression Nested Too Deep.\");\n}\n");
+      continue;
+    }
+    
+    mpc_result_t r;
+    if (!mpc_parse(path, line, p, &r)) {
+      fprintf(stderr, "%s:%i: ", path, lineno);
+      mpc_err_print_to(r.error, stderr);
+      mpc_err_delete(r.error);
+      free(line);
+      fclose(in);
+      lenv_del(e);
+      return 1;
+    }
+    
+    lval* v = lfold_line(&f, lval_read(r.output));
+    mpc_ast_delete(r.output);
+    
+    fprintf(a.out, "\nstatic lval* laot_line_%d(lenv* e) {\n", count++);
+    if (lform_find(v) >= 0) {
+      laot_push(&a, v, 2);
+      fprintf(a.out, "  return laot_pop();\n}\n");
+    } else {
+      for (int i = 0; i < v->count; i++) {
+        laot_push(&a, v->cell[i], 2);
+      }
+      fprintf(a.out, "  return lvm_call(e, %d);\n}\n", v->count);
+    }
+    lval_del(v);
   }
+  free(line);
+  fclose(in);
+  lenv_del(e);
   
-  if (v->count == 0) { return v; }  
-  if (v->count == 1) { return lval_take(v, 0); }
+  fprintf(a.out, "\nstatic char* lsym_names[] = {");
+  for (int i = 0; i < a.sym_count; i++) {
+    fprintf(a.out, i % 8 ? " " : "\n  ");
+    laot_string(&a, a.syms[i]);
+    fprintf(a.out, ",");
+  }
+  fprintf(a.out, "\n  NULL\n};\n");
   
-  /* Ensure first element is a function after evaluation */
-  lval* f = lval_pop(v, 0);
-  if (f->type != LVAL_FUN) {
-    lval* err = lval_err(
-      "S-Expression starts with incorrect type. "
-      "Got %s, Expected %s.",
-      ltype_name(f->type), ltype_name(LVAL_FUN));
-    lval_del(f); lval_del(v);
-    return err;
+  fprintf(a.out, "\nstatic lval*(*laot_lines[])(lenv*) = {");
+  for (int i = 0; i < count; i++) {
+    fprintf(a.out, i % 4 ? " " : "\n  ");
+    fprintf(a.out, "laot_line_%d,", i);
   }
+  fprintf(a.out, "\n  NULL\n};\n");
   
-  /* If so call function to get result */
-  lval* result = f->fun(e, v);
-  lval_del(f);
-  return result;
+  fprintf(a.out,
+    "\n"
+    "int main(int argc, char** argv) {\n"
+    "  lsym_table = malloc(sizeof(char*) * %d);\n"
+    "  for (int i = 0; i < %d; i++) {\n"
+    "    lsym_table[i] = lsym_intern(lsym_names[i]);\n"
+    "  }\n"
+    "  return vhisp_run(laot_lines, %d);\n"
+    "}\n",
+    a.sym_count + 1, a.sym_count, count);
+  
+  free(a.syms);
+  return 0;
 }
 
-lval* lval_eval(lenv* e, lval* v) {
-  if (v->type == LVAL_SYM) {
-    lval* x = lenv_get(e, v);
-    lval_del(v);
-    return x;
-  }
-  if (v->type == LVAL_SEXPR) { return lval_eval_sexpr(e, v); }
-  return v;
+/* Tests the value on top of the root stack as argument arg of form */
+/* k, for a compiled script. Returns as lform_test, leaving the value */
+/* or the error that replaced it on the stack.                        */
+int laot_test(int k, int arg) {
+  return lform_test(k, arg, &lgc.roots[lgc.root_count-1]);
 }
 
-/* Reading */
+/* Checks the value on top of the root stack is an error */
+int laot_failed(void) {
+  return lval_type(lgc.roots[lgc.root_count-1]) == LVAL_ERR;
+}
 
-lval* lval_read_num(mpc_ast_t* t) {
-  errno = 0;
-  long x = strtol(t->contents, NULL, 10);
-  return errno != ERANGE ? lval_num(x) : lval_err("Invalid Number.");
+/* Releases the value on top of the root stack */
+void laot_drop(void) {
+  lval_del(lgc.roots[--lgc.root_count]);
 }
 
-lval* lval_read(mpc_ast_t* t) {
-  
-  if (strstr(t->tag, "number")) { return lval_read_num(t); }
-  if (strstr(t->tag, "symbol")) { return lval_sym(t->contents); }
+/* Takes the value on top of the root stack */
+lval* laot_pop(void) {
+  return lgc.roots[--lgc.root_count];
+}
+
+/* Runs the lines of a compiled script, printing each result as the */
+/* prompt would                                                     */
+int vhisp_run(lval*(**lines)(lenv*), int count) {
   
-  lval* x = NULL;
-  if (strcmp(t->tag, ">") == 0) { x = lval_sexpr(); } 
-  if (strstr(t->tag, "sexpr"))  { x = lval_sexpr(); }
-  if (strstr(t->tag, "qexpr"))  { x = lval_qexpr(); }
+  lenv* e = lenv_new();
+  lenv_add_builtins(e);
   
-  for (int i = 0; i < t->children_num; i++) {
-    if (strcmp(t->children[i]->contents, "(") == 0) { continue; }
-    if (strcmp(t->children[i]->contents, ")") == 0) { continue; }
-    if (strcmp(t->children[i]->contents, "}") == 0) { continue; }
-    if (strcmp(t->children[i]->contents, "{") == 0) { continue; }
-    if (strcmp(t->children[i]->tag,  "regex") == 0) { continue; }
-    x = lval_add(x, lval_read(t->children[i]));
+  for (int i = 0; i < count; i++) {
+    lval* x = lines[i](e);
+    lval_println(x);
+    lval_del(x);
+    lfree_slice();
+    lgc_minor();
   }
   
-  return x;
+  lenv_del(e);
+  return 0;
 }
 
 /* Main */
 
+#ifndef VHISP_NO_MAIN
+
 int main(int argc, char** argv) {
   
   mpc_parser_t* Number = mpc_new("number");
@@ -621,7 +5315,7 @@ int main(int argc, char** argv) {
   mpca_lang(MPCA_LANG_DEFAULT,
     "                                                     \
       number : /-?[0-9]+/ ;                               \
-      symbol : /[a-zA-Z0-9_+\\-*\\/\\\\=<>!&]+/ ;         \
+      symbol : /[a-zA-Z0-9_+\\-*\\/\\\\=<>!&?]+/ ;        \
       sexpr  : '(' <expr>* ')' ;                          \
       qexpr  : '{' <expr>* '}' ;                          \
       expr   : <number> | <symbol> | <sexpr> | <qexpr> ;  \
@@ -629,6 +5323,13 @@ int main(int argc, char** argv) {
     ",
     Number, Symbol, Sexpr, Qexpr, Expr, Vhisp);
   
+  /* vhisp -c file compiles a script to C rather than starting the prompt */
+  if (argc == 3 && strcmp(argv[1], "-c") == 0) {
+    int status = laot_compile(argv[2], Vhisp);
+    mpc_cleanup(6, Number, Symbol, Sexpr, Qexpr, Expr, Vhisp);
+    return status;
+  }
+  
   puts("Vhisp Version 0.5");
   puts("Press Ctrl+c to Exit\n");
   
@@ -638,14 +5339,23 @@ int main(int argc, char** argv) {
   while (1) {
   
     char* input = readline("vhisp> ");
+    if (!input) { break; }
     add_history(input);
     
     mpc_result_t r;
-    if (mpc_parse("<stdin>", input, Vhisp, &r)) {
-      lval* x = lval_eval(e, lval_read(r.output));
+    if (lread_too_deep(input)) {
+      lval* x = lval_err("Expression Nested Too Deep.");
+      lval_println(x);
+      lval_del(x);
+    } else if (mpc_parse("<stdin>", input, Vhisp, &r)) {
+      lval* x = lval_eval_top(e, r.output, input);
       lval_println(x);
       lval_del(x);
       mpc_ast_delete(r.output);
+      
+      /* Nothing is live outside the environment here */
+      lfree_slice();
+      lgc_minor();
     } else {    
       mpc_err_print(r.error);
       mpc_err_delete(r.error);
@@ -655,9 +5365,13 @@ int main(int argc, char** argv) {
     
   }
   
+  /* Release everything the session made */
   lenv_del(e);
+  ltier_lines_del();
   
   mpc_cleanup(6, Number, Symbol, Sexpr, Qexpr, Expr, Vhisp);
   
   return 0;
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,57 @@
+(+ 1 2)
+(def {x} 5)
+(* x x)
+(** 2 3)
+(** 3 0)
+(head {1 2 3})
+(tail {1 2 3})
+(eval {+ 1 2})
+(join {1} {2 3} {4 {5 6}})
+(/ 1 0)
+(/ 7 2)
+(& 12 10)
+(- 5)
+(- 10 1 2)
+(max 1 5 3)
+(min 4 2 8)
+(> 1 9)
+(< 3 1)
+(foo)
+()
+(1)
+(1 2)
+{1 2 (+ 1 2)}
+(list 1 2 (+ 3 4))
+(def {a b} 1 2)
+(+ a b)
+(def {a} 1 2)
+(def {1} 2)
+(def 1 2)
+(head {})
+(tail 1)
+(head 1 2)
+(eval {def {y} {1 2 3}})
+(head y)
+(tail y)
+(eval (join {+} y))
+(+ 1 {2})
+(+ 1 (/ 1 0) (def {z} 9))
+z
+(def {x} 100)
+x
+head
+(head (list head tail))
+(eval (head {(+ 1 2) (+ 3 4)}))
+(join)
+9999999999999999999999
+-42
+(- -5)
+(+ 1 (+ 2 (+ 3 (+ 4 5))))
+(eval {})
+(eval {{1 2}})
++
+(def {add2} {+ 2})
+(eval (join add2 {3}))
+(join {1} 2)
+(list)
+(eval (list + 1 2))
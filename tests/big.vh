@@ -0,0 +1,26 @@
+(def {a} (** 7 1000))
+(def {b} (- (** 3 2000) 1))
+(def {c} (** 13 3000))
+a
+(* a b)
+(* a (- b))
+(* (- a) (- b))
+(* c c)
+(/ c a)
+(mod c a)
+(/ (- c) b)
+(mod (- c) b)
+(/ (* a b) b)
+(- (* a b) (* b a))
+(/ c (* a b) 7)
+(/ a c)
+(/ c 0)
+(** 123456789 500)
+(** -3 1001)
+(+ (** 2 4096) -1)
+(max a b)
+(min a (- b))
+(< a b)
+(> a b)
+(** 3 20000000)
+(** 2 16777217)
@@ -0,0 +1,29 @@
+(def {f} {+ 1 (* 2 3) (- 10 4)})
+(eval f)
+(eval f)
+(def {+} -)
+(eval f)
+(eval f)
+(def {+} add)
+(eval f)
+(def {g} {head (list 1 2 3)})
+(eval g)
+(eval g)
+(def {head} tail)
+(eval g)
+(eval g)
+(def {h} {/ 10 0})
+(eval h)
+(eval h)
+(def {k} {max 1 {2} x})
+(eval k)
+(eval k)
+(def {m} {min 5 (+ 1 1) 9 -3})
+(eval m)
+(eval m)
+(+ 4611686018427387903 4611686018427387903 1)
+(- 7)
+(pow 2 3)
+(eval {eval {+ 1 2}})
+when 1 (def {s} {9}) (backend {closure}) (eval s)
+when 1 (def {t} {11}) (backend {vm}) (eval t) (backend {closure}) (eval t)
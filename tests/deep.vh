@@ -0,0 +1,9 @@
+(def {x} 1)
+(+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x (+ x 0))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))
+(def {f} (\ {y} {(+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y (+ y 0))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))}))
+(f 2)
+(f x)
+(- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 (- 0 x))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))
+(eval {(* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 (* 1 x))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))})
+((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((((()))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))))
+(+ x 1)
@@ -0,0 +1,15 @@
+(def {l} {1 {2 {3 {4}}} 100000000000000000000000})
+(def {mk} (\ {a} {\ {b} {\ {c} {list a b c}}}))
+(def {k} ((mk 1) 2))
+(k 3)
+(def {down} (\ {n} {if n (down (- n 1)) (mk n)}))
+(def {m} (down 100))
+((m 5) 6)
+(def {q} {+ (* 2 3) 1})
+(def {r} (list (eval q) (eval q) (eval q) (eval q) (eval q) (eval q) (eval q) (eval q) (eval q) (eval q)))
+(def {ks} (list k k m l q))
+(def {k} 0)
+(def {m} 0)
+(def {big} (** 3 200))
+(join ks ks)
+r
@@ -0,0 +1,46 @@
+(+ 1 2 (* 3 4))
++ 1 2
+(- 5)
+(- 10 1 2)
+(- x 0)
+(def {x} 5)
+(- x 0)
+(- 0 x)
+(+ 0 x)
+(+ x 0)
+(* 1 (* x 2) 1)
+(+ 1 (+ 2 (+ 3 x)))
+(+ 1 (+ 2 {a}))
+(+ {a} 0)
+(+ 0 {a})
+(- 0 {a} 0)
+(* {a} 1 1)
+(/ 10 0)
+(/ x 1)
+(/ 1 x)
+(and -1 x)
+(or 0 0 x)
+(min 3 (min 1 x) 2)
+(max (max 1 2) (max x 9))
+(pow 2 3 2)
+(def {+} -) (+ 1 2)
+(+ 1 2)
+(def {+} add)
+(+ (def {+} -) 5 3)
+(+ 5 3)
+(def {+} add)
+(eval {+ 1 2 (* 3 4)})
+(def {f} {+ 1 (* 2 3) (- 10 4)})
+(eval f)
+(eval f)
+(def {*} add)
+(eval f)
+(eval f)
+(def {*} mul)
+(eval f)
+(+ 4611686018427387903 1)
+(- 1 2 (+ 3 x) 0)
+(+ (/ 1 0) (+ 2 (- 3 4)))
+(+ 1 (head {2}))
+(- 9223372036854775807 -1)
+(* 4611686018427387903 3 0 x)
@@ -0,0 +1,70 @@
+(if 1 10 20)
+(if 0 10 20)
+(if (- 3 3) (def {bad} 1) (+ 1 2))
+bad
+(if 1 {a b} {c})
+(if {x} 1 2)
+(if 1 2)
+(if (/ 1 0) 1 2)
+(if 100000000000000000000000 7 8)
+(cond 0 1 0 2 1 3 1 4)
+(cond 0 1)
+(cond)
+(cond 0 1 5)
+(cond 0 (def {bad2} 1) 1 (* 6 7))
+bad2
+(when 1 (def {w} 5) (+ w 1))
+(when 0 (def {w2} 5))
+w2
+(when 1)
+(when)
+(when 1 (/ 1 0) 5)
+(and? 1 2 3)
+(and? 1 0 (def {bad3} 1))
+bad3
+(and?)
+(or?)
+(or? 0 0)
+(or? 0 7 (def {bad4} 1))
+bad4
+(and? 1 {x})
+(and? {x} 1)
+(or? 0 (/ 1 0))
+(def {loop} (\ {n acc} {if n (loop (- n 1) (+ acc n)) acc}))
+(loop 100000 0)
+(def {fib} (\ {n} {cond (- n 1) (if n (+ (fib (- n 1)) (fib (- n 2))) 0) 1 1}))
+(fib 15)
+(def {even} (\ {n} {if n (odd (- n 1)) 1}))
+(def {odd} (\ {n} {if n (even (- n 1)) 0}))
+(even 10001)
+(def {f} (\ {x} {when x (def {side} x) (and? x (or? 0 x))}))
+(f 3)
+side
+(f 0)
+(eval {if 0 (undefined) 9})
+(def {g} (\ {x} {(if x + -) 10 x}))
+(g 3)
+(g 0)
+(def {h} (\ {x} {if x (if (- x 1) 1 2) (cond x 3 1 4)}))
+(h 0)
+(h 1)
+(h 2)
+(if 1 2 3 4)
+if
+(eval (join {if} {0 (undefined) 2}))
+(def {boom} (\ {n} {/ n 0}))
+(if 1 7 (boom 0))
+(if 0 (boom 0) 8)
+(cond 0 (boom 0) 1 9 1 (boom 0))
+(when 0 (boom 0))
+(and? 0 (boom 0))
+(or? 3 (boom 0))
+(def {pick} (\ {c} {if c 1 (boom c)}))
+(def {rep} (\ {n} {if n (rep (- n (pick n))) 0}))
+(rep 50)
+(def {guard} (\ {n} {and? n (/ 10 n)}))
+(list (guard 0) (guard 5))
+(def {side} (\ {c} {cond c (def {taken} c) 1 (def {skipped} c)}))
+(side 4)
+taken
+skipped
@@ -0,0 +1,25 @@
+(def {y} 1)
+(def {c} {+ y 1})
+(def {run} (\ {n acc} {if n (run (- n 1) (eval c)) acc}))
+(run 20 0)
+(def {y} 10)
+(run 20 0)
+(eval c)
+(def {+} -)
+(run 20 0)
+(eval c)
+(def {+} max)
+(eval c)
+(def {+} add)
+(run 20 0)
+(def {runy} (\ {y n acc} {if n (runy y (- n 1) (eval c)) acc}))
+(runy 100 20 0)
+(run 20 0)
+(def {runop} (\ {+ n acc} {if n (runop + (- n 1) (eval c)) acc}))
+(runop - 20 0)
+(runop min 20 0)
+(run 20 0)
+(def {y} 5)
+(runy 100 20 0)
+(runop - 20 0)
+(eval c)
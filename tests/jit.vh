@@ -0,0 +1,187 @@
+(def {x y z} 7 -3 100)
+(def {f} {+ (* x y) (- z) (/ z y) (mod z y) (min x y z) (max x y) (and x 12) (or y 1) (pow 2 x) (- 4611686018427387903 -4611686018427387903)})
+(def {g} {/ x (- y y)})
+(def {h} {mul 3 (sub (div 100 x) (pow y 2)) (- x)})
+(def {k} {max (min x 4) (- 1 2 3 4) (* x x x x x x x x x x x x x x x x x x x x x x x x)})
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(def {x} {1})
+(eval f)
+(eval h)
+(eval f)
+(eval h)
+(eval f)
+(eval h)
+(def {x} 5)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(eval f)
+(eval g)
+(eval h)
+(eval k)
+(def {y} 0)
+(eval g)
+(eval h)
+(eval k)
+(def {y} -3)
+(eval f)
+(def {+} -)
+(eval f)
+(eval f)
+def {x} 3
+def {q} {+ (* x 2) 1}
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+eval q
+def {g} (\ {*} {eval q})
+g -
+g max
+eval q
+def {r} {+ x (* 2 3)}
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+eval r
+def {h} (\ {*} {eval r})
+h -
+eval r
+def {*} -
+eval q
+eval r
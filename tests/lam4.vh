@@ -0,0 +1,7 @@
+(def {adder} (\ {x} {\ {y} {join x y}}))
+(def {adders} (\ {n acc} {if n (adders (- n 1) (list (adder (list (- n 1) (+ 100000000000000000000 (- n 1)))) acc)) acc}))
+(def {nth} (\ {n l} {if n (nth (- n 1) (eval (head (tail l)))) (eval (head l))}))
+(def {ws} (adders 3000 {}))
+(def {w} (nth 2 ws))
+(def {ws} 0)
+(w {1})
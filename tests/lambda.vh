@@ -0,0 +1,147 @@
+(\ {x} {+ x 1})
+(def {inc} (\ {x} {+ x 1}))
+(inc 41)
+inc
+(def {add} (\ {x y} {+ x y}))
+(add 2 3)
+(add 2)
+(add 1 2 3)
+(\ {1} {x})
+(\ 1 {x})
+(\ {x})
+(def {adder} (\ {x} {\ {y} {+ x y}}))
+(def {add5} (adder 5))
+add5
+(add5 10)
+((adder 1) 2)
+(def {compose} (\ {f g} {\ {x} {f (g x)}}))
+((compose inc add5) 0)
+(def {len} (\ {l} {eval (join {+ 1} (list (len (tail l))))}))
+(def {sum} (\ {l} {eval (head (list (eval (join {+} l))))}))
+(sum {1 2 3 4})
+(def {twice} (\ {f x} {f (f x)}))
+(twice inc 5)
+(twice (adder 3) 1)
+(def {shadow} (\ {+} {+ 1 2}))
+(shadow max)
+(shadow min)
+(def {y} 100)
+(def {gety} (\ {a} {+ a y}))
+(gety 1)
+(def {y} 200)
+(gety 1)
+(def {definer} (\ {v} {def {gv} v}))
+(definer 7)
+gv
+(def {curry3} (\ {a} {\ {b} {\ {c} {list a b c}}}))
+(((curry3 1) 2) 3)
+(def {k} ((curry3 {x}) (list y y)))
+(k 9)
+(inc {1})
+(inc unbound)
+(def {fact} (\ {n} {eval (head (tail (list n (* n 1))))}))
+(fact 5)
+(def {h} (\ {x} {x}))
+(h 3)
+(h h)
+(def {many} (\ {a b c d e f g h i j} {+ a b c d e f g h i j}))
+(many 1 2 3 4 5 6 7 8 9 10)
+(backend {vm})
+(add 4 5)
+((adder 2) 3)
+(twice (adder 3) 1)
+(shadow max)
+(backend {closure})
+(add 4 5)
+((adder 2) 3)
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(backend {tree})
+(add 4 5)
+((adder 2) 3)
+(backend {tiered})
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(add5 (inc 1))
+(twice (adder 3) 1)
+(shadow max)
+(shadow min)
+(gety 2)
+(def {y} 1)
+(gety 2)
+(def {adder} (\ {x} {\ {y} {+ x y}}))
+(def {keep} (\ {x} {\ {y} {join x y}}))
+(def {a} (adder 99999999999999999999))
+(def {b} (keep (list 1 (list 2 3) 99999999999999999999)))
+(a 1)
+(b {4})
+(def {fs} (list (adder 1) (adder 2) (keep {7})))
+((eval (head fs)) 10)
+((eval (head (tail (tail fs)))) {8})
+(def {mk} (\ {n} {list (adder n) (keep (list n n))}))
+(def {p} (mk 5))
+((eval (head p)) 1)
+((eval (head (tail p))) {6})
+(\ {} {1})
+(def {z} (\ {} {+ 1 2}))
+z
+(def {one} (\ {_} {1}))
+(one {})
+def {deep} (\ {n} {if n (+ 1 (deep (- n 1))) 0})
+deep 1000
+deep 1000000
+deep 10
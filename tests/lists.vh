@@ -0,0 +1,21 @@
+(def {l} {1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26 27 28 29 30 31 32 33 34 35})
+(def {l2} (join l l l l l l l l l l l l l l l l l l l l))
+(def {l3} (join l2 l2 l2 l2 l2 l2 l2 l2 l2 l2))
+(eval (join {+} l3))
+(eval (join {max} l3))
+(tail (tail (tail l)))
+(head (tail (tail l3)))
+(eval (join {+} (tail l3)))
+(eval (join {+} (tail (tail (tail l2)))))
+(join {} {})
+(tail {1})
+(def {n} {-1 -2 -3 -4 -5 -6 -7 -8 -9 -10 -11 -12 -13 -14 -15 -16 -17 -18 -19 -20})
+(eval (join {+} n))
+(eval (join {min} l n))
+(eval (join {max} n))
+(eval (join {+} {4611686018427387903 4611686018427387903 4611686018427387903} l))
+(eval (join {+} {-4611686018427387904 -4611686018427387904 -4611686018427387904} n))
+(eval (join {+} l {4611686018427387904} n))
+(eval (join {min} l {-9223372036854775808} n))
+(eval (join {max} n {9223372036854775807} l))
+(eval (join {+} {4611686018427387903} l l))
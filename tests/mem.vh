@@ -0,0 +1,13 @@
+(def {g} (gc {200 65536 250}))
+(tail (tail (tail (tail (tail (memstats {free}))))))
+(def {l} {1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20})
+(def {l} (join l l l l l l l l l l))
+(def {l} (join l l l l l))
+(def {m} (eval (tail (list (def {l} 0) (memstats {free})))))
+(min 1000 (eval (head m)))
+(eval (join {min 0} m))
+(min 1 (eval (head (tail (tail (memstats {free}))))))
+(min 1000 (eval (head (tail (memstats {free})))))
+(memstats {heap})
+(def {g} (gc {200 65536 500}))
+(tail (tail (tail (tail (tail (memstats {free}))))))
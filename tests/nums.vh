@@ -0,0 +1,14 @@
+(+ 4611686018427387903 1)
+(- -4611686018427387904 1)
+(def {big} 9223372036854775807)
+big
+(- big 1)
+(list big big)
+(head (list big 1))
+(max big 1)
+(min -9223372036854775808 0)
+(* 3037000499 3037000499)
+(+ 1 2 3 4 5 6 7 8 9 10)
+(* 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20)
+(/ 100 3 2)
+(- 0 4611686018427387904)
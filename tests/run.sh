@@ -0,0 +1,78 @@
+#!/bin/sh
+# Runs every tests/*.vh script on each evaluation backend, plainly and
+# with a collection at every safe point, and compares what each line
+# prints with tests/*.out. Each script is also compiled to C with
+# vhisp -c, built against src/ and run, and must print the same. Set
+# VHISP to a built binary to test that; otherwise src/ is built with $CC
+# and $CFLAGS.
+#
+#   tests/run.sh
+#   VHISP=./vhisp tests/run.sh
+
+cd "$(dirname "$0")" || exit 1
+
+built=
+if [ -z "$VHISP" ]; then
+  VHISP=$(mktemp)
+  built=$VHISP
+  ${CC:-cc} -O2 $CFLAGS ../src/main.c ../src/mpc.c -ledit -lm -o "$VHISP" || exit 1
+fi
+
+raw=$(mktemp)
+out=$(mktemp)
+fail=0
+
+for f in *.vh; do
+  for backend in tree vm closure tiered; do
+    for gc in "" "gc {100 0}"; do
+
+      # Skip the banner and the lines setting things up, and drop prompts
+      skip=4
+      [ -n "$gc" ] && skip=5
+      { echo "backend {$backend}"; [ -n "$gc" ] && echo "$gc"; cat "$f"; } \
+        | "$VHISP" > "$raw"
+      status=$?
+      sed -e 's/^\(vhisp> \)*//' "$raw" | sed -e "1,${skip}d" -e '/^$/d' > "$out"
+
+      if [ $status != 0 ]; then
+        echo "FAIL $f on $backend${gc:+ with $gc}: exit status $status"
+        fail=1
+      elif ! diff "${f%.vh}.out" "$out" > /dev/null; then
+        echo "FAIL $f on $backend${gc:+ with $gc}"
+        diff "${f%.vh}.out" "$out" | head -10
+        fail=1
+      fi
+    done
+  done
+done
+
+# The runtime for compiled scripts is built once and linked with each
+aot=$(mktemp -d)
+${CC:-cc} -O2 $CFLAGS -DVHISP_NO_MAIN -c ../src/main.c -o "$aot/main.o" || exit 1
+${CC:-cc} -O2 $CFLAGS -c ../src/mpc.c -o "$aot/mpc.o" || exit 1
+
+for f in *.vh; do
+  if ! "$VHISP" -c "$f" > "$aot/script.c"; then
+    echo "FAIL $f compiled to C: vhisp -c failed"
+    fail=1
+    continue
+  fi
+  ${CC:-cc} -O2 $CFLAGS "$aot/script.c" "$aot/main.o" "$aot/mpc.o" -lm \
+    -o "$aot/script" || exit 1
+  "$aot/script" > "$raw"
+  status=$?
+  sed -e '/^$/d' "$raw" > "$out"
+  
+  if [ $status != 0 ]; then
+    echo "FAIL $f compiled to C: exit status $status"
+    fail=1
+  elif ! diff "${f%.vh}.out" "$out" > /dev/null; then
+    echo "FAIL $f compiled to C"
+    diff "${f%.vh}.out" "$out" | head -10
+    fail=1
+  fi
+done
+
+rm -rf "$raw" "$out" "$aot" $built
+[ $fail = 0 ] && echo "All tests passed."
+exit $fail
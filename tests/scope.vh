@@ -0,0 +1,21 @@
+(def {y} 100)
+(def {f} (\ {x} {+ x y}))
+(f 1)
+(def {g} (\ {y} {+ y y}))
+(g 3)
+(def {adder} (\ {a} {\ {b} {+ a b y}}))
+((adder 1) 2)
+(def {ev} (\ {n} {even n}))
+(def {even} (\ {n} {if n (odd (- n 1)) 1}))
+(def {odd} (\ {n} {if n (even (- n 1)) 0}))
+(ev 10)
+(ev 7)
+(def {h} (\ {x} {eval {+ x 1}}))
+(h 5)
+(def {k} (\ {x} {+ x zz}))
+(k 1)
+(def {zz} 2)
+(k 1)
+(def {y} 1000)
+(f 1)
+((adder 1) 2)
@@ -0,0 +1,33 @@
+(def {l} {1 2 3 (+ 4 5)})
+(tail l)
+l
+(head l)
+l
+(join l l)
+l
+(eval (tail (tail (tail l))))
+l
+(def {n} 7)
+(+ n 1)
+n
+(- n)
+n
+(def {e} {+ 1 2})
+(eval e)
+e
+(def {m} l)
+(def {l} 0)
+m
+(eval (list (def {q} {1}) q))
+(join q q q)
+q
+(def {twice} (\ {n l} {if n (twice (- n 1) (join l l)) l}))
+(def {a} (twice 11 {{0 (+ 0 1) x} {1 (+ 1 1) x} {2 (+ 2 1) x} {3 (+ 3 1) x}}))
+(def {b} (join a a {q}))
+(eval (head (tail (tail (tail b)))))
+(eval (join {+} (list 1 2 3) (head (tail b))))
+(def {c} (list (join a {z}) (tail b) (head a)))
+(head (tail (tail c)))
+(def {a} 0)
+(eval (head (tail (eval (head (tail c))))))
+(head (tail (tail (head c))))
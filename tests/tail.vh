@@ -0,0 +1,42 @@
+(def {f} (\ {n d} {f (- n 1) (/ 1 n)}))
+(f 20000 0)
+(def {g} (\ {n d} {eval {g (- n 1) (/ 1 n)}}))
+(g 20000 0)
+(def {a} (\ {n d} {b (- n 1) (/ 1 n)}))
+(def {b} (\ {n d} {a n d}))
+(a 20000 0)
+(def {l} {1})
+(def {l} (join l l l l l l l l l l))
+(def {l} (join l l l l l l l l l l))
+(def {l} (join l l l l l l l l l l))
+(def {len} (\ {l n} {len (tail l) (+ n 1)}))
+(len l 0)
+(def {cap} (\ {n k d} {cap (- n 1) (\ {x} {+ n x}) (/ 1 n)}))
+(cap 100 0 0)
+(def {last} (\ {n k d} {eval (list (\ {m j} {last m j 0}) (- n 1) (\ {x} {list n x}))}))
+(def {mk} (\ {n k} {eval (head (list {k 0} (/ 1 (- n 1))))}))
+(def {loop} (\ {n k} {loop2 (- n 1) (\ {x} {list n x k})}))
+(def {loop2} (\ {n k} {eval (list (mk n k) 1)}))
+(loop 3 0)
+(def {swap} (\ {a b c} {swap2 b a}))
+(def {swap2} (\ {a b} {swap a b (/ 1 a)}))
+(swap 5 0 1)
+(def {bad} (\ {n} {swap 1 2}))
+(bad 1)
+(def {id} (\ {x} {x}))
+(def {ret} (\ {x} {id x}))
+(ret 42)
+(def {k2} (\ {a} {\ {b} {\ {c} {list a b c}}}))
+(def {tk} (\ {x} {(k2 x) 2}))
+((tk 1) 3)
+(def {count} (\ {n} {if n (count (- n 1)) 0}))
+(count 1000000)
+(def {ev} (\ {n} {if n (od (- n 1)) 1}))
+(def {od} (\ {n} {if n (ev (- n 1)) 0}))
+(ev 1000001)
+(def {down} (\ {n} {cond n (down (- n 1)) 1 7}))
+(down 1000000)
+(def {spin} (\ {n} {when n (eval {spin (- n 1)})}))
+(spin 1000000)
+(def {sum} (\ {l n acc} {if n (sum (tail l) (- n 1) (+ acc (eval (head l)))) acc}))
+(sum l 1000 0)
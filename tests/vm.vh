@@ -0,0 +1,48 @@
+(def {c} {+ 1 x})
+(def {x} 1)
+(eval c)
+(eval c)
+(def {x} 5)
+(eval c)
+(eval (tail c))
+c
+(eval (join c {10}))
+(eval c)
+(def {d} {eval c})
+(eval d)
+(eval d)
+(def {x} {1 2})
+(eval c)
+(eval d)
+(def {x} 3)
+(def {e} {(def {x} 100) x})
+(eval e)
+(eval e)
+x
+(def {f} {(+ 1 2) (/ 1 0) (def {y} 7)})
+(eval f)
+(eval f)
+y
+(def {g} {})
+(eval g)
+(eval g)
+(def {h} {(()) ()})
+(eval h)
+(eval h)
+(def {k} {head {1 2 3}})
+(eval k)
+(eval k)
+(eval (head (list c d)))
+(def {z} (list c c))
+(eval (head z))
+(eval (eval (head (list z))))
+(def {c} 0)
+(eval (head z))
+(eval (head z))
+(eval {eval {eval {+ 1 2}}})
+(def {w} {eval {eval {+ 1 2}}})
+(eval w)
+(eval w)
+(def {self} {eval self})
+when 1 (def {q} {5}) (backend {vm}) (eval q)
+when 1 (def {r} {7}) (backend {closure}) (eval r) (backend {vm}) (eval r)